@@ -10,6 +10,7 @@
 #include "tfm_plat_provisioning.h"
 #include "tfm_plat_otp.h"
 #include "boot_hal.h"
+#include "boot_timeline.h"
 #include "boot_measurement.h"
 #include "psa/crypto.h"
 #include "region_defs.h"
@@ -86,11 +87,15 @@ static fih_int validate_image_at_addr(uint8_t *image)
 int main(void)
 {
     fih_int fih_rc = FIH_FAILURE;
+    BOOT_TIMELINE_TIMESTAMP(start_ts);
 
     fih_rc = fih_int_encode_zero_equality(boot_platform_init());
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         FIH_PANIC;
     }
+
+    /* The platform init clears the shared data area, record the start now */
+    BOOT_TIMELINE_CHECKPOINT_AT(BTL_STAGE_BL1_1, BTL_CP_START, 0, start_ts);
     BL1_LOG("[INF] Starting TF-M BL1_1\r\n");
 
     if (tfm_plat_provisioning_is_required()) {
@@ -117,11 +122,13 @@ int main(void)
     }
 
     /* Copy BL1_2 from OTP into SRAM*/
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL1_1, BTL_CP_IMAGE_COPY, 0);
     FIH_CALL(bl1_read_bl1_2_image, fih_rc, (uint8_t *)BL1_2_CODE_START);
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         FIH_PANIC;
     }
 
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL1_1, BTL_CP_IMAGE_HASH, 0);
     FIH_CALL(validate_image_at_addr, fih_rc, (uint8_t *)BL1_2_CODE_START);
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         BL1_LOG("[ERR] BL1_2 image failed to validate\r\n");
@@ -138,6 +145,7 @@ int main(void)
 #endif /* TFM_MEASURED_BOOT_API */
 
     BL1_LOG("[INF] Jumping to BL1_2\r\n");
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL1_1, BTL_CP_JUMP, 0);
     /* Jump to BL1_2 */
     boot_platform_quit((struct boot_arm_vector_table *)BL1_2_CODE_START);
 
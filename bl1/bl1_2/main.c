@@ -8,6 +8,7 @@
 #include "crypto.h"
 #include "otp.h"
 #include "boot_hal.h"
+#include "boot_timeline.h"
 #include "boot_measurement.h"
 #include "psa/crypto.h"
 #include "uart_stdout.h"
@@ -117,6 +118,7 @@ static fih_int is_image_signature_valid(struct bl1_2_image_t *img)
 
     /* Calculate the image hash for measured boot and/or a hash-locked image */
 #if defined(TFM_MEASURED_BOOT_API) || !defined(TFM_BL1_PQ_CRYPTO)
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL1_2, BTL_CP_IMAGE_HASH, 0);
     FIH_CALL(bl1_sha256_compute, fih_rc, (uint8_t *)&img->protected_values,
                                          sizeof(img->protected_values),
                                          computed_bl2_hash);
@@ -125,6 +127,7 @@ static fih_int is_image_signature_valid(struct bl1_2_image_t *img)
     }
 #endif
 
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL1_2, BTL_CP_SIG_VERIFY, 0);
 #ifdef TFM_BL1_PQ_CRYPTO
     FIH_CALL(pq_crypto_verify, fih_rc, TFM_BL1_KEY_ROTPK_0,
                                        (uint8_t *)&img->protected_values,
@@ -178,6 +181,8 @@ static fih_int copy_and_decrypt_image(uint32_t image_id)
     uint8_t key_buf[32];
     uint8_t label[] = "BL2_DECRYPTION_KEY";
 
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL1_2, BTL_CP_IMAGE_COPY, image_id);
+
 #ifdef TFM_BL1_MEMORY_MAPPED_FLASH
     /* If we have memory-mapped flash, we can do the decrypt directly from the
      * flash and output to the SRAM. This is significantly faster if the AES
@@ -209,6 +214,8 @@ static fih_int copy_and_decrypt_image(uint32_t image_id)
         FIH_RET(FIH_FAILURE);
     }
 
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL1_2, BTL_CP_IMAGE_DECRYPT, image_id);
+
     /* The image security counter is used as a KDF input */
     rc = bl1_derive_key(TFM_BL1_KEY_BL2_ENCRYPTION, label, sizeof(label),
                         (uint8_t *)&image_after_decrypt->protected_values.security_counter,
@@ -264,6 +271,8 @@ int main(void)
 {
     fih_int fih_rc = FIH_FAILURE;
 
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL1_2, BTL_CP_START, 0);
+
     fih_rc = fih_int_encode_zero_equality(boot_platform_init());
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         FIH_PANIC;
@@ -307,6 +316,7 @@ int main(void)
 #endif /* TFM_MEASURED_BOOT_API */
 
     BL1_LOG("[INF] Jumping to BL2\r\n");
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL1_2, BTL_CP_JUMP, 0);
     boot_platform_quit((struct boot_arm_vector_table *)BL2_CODE_START);
 
     FIH_PANIC;
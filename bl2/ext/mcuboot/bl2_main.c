@@ -28,6 +28,7 @@
 #include "bootutil/fault_injection_hardening.h"
 #include "flash_map_backend/flash_map_backend.h"
 #include "boot_hal.h"
+#include "boot_timeline.h"
 #include "uart_stdout.h"
 #include "tfm_plat_otp.h"
 #include "tfm_plat_provisioning.h"
@@ -97,6 +98,8 @@ int main(void)
     enum tfm_plat_err_t plat_err;
     int32_t image_id;
 
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL2, BTL_CP_START, 0);
+
     /* Initialise the mbedtls static memory allocator so that mbedtls allocates
      * memory from the provided static buffer instead of from the heap.
      */
@@ -173,6 +176,8 @@ int main(void)
          * done anyway as a good practice to sanitize memory.
          */
         memset(&rsp, 0, sizeof(struct boot_rsp));
+        /* MCUboot copies, decrypts, hashes and verifies the image in one go */
+        BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL2, BTL_CP_IMAGE_LOAD, image_id);
         FIH_CALL(boot_go_for_image_id, fih_rc, &rsp, image_id);
         if (FIH_NOT_EQ(fih_rc, FIH_SUCCESS)) {
             BOOT_LOG_ERR("Unable to find bootable image");
@@ -188,6 +193,7 @@ int main(void)
     BOOT_LOG_INF("Bootloader chainload address offset: 0x%x",
                  rsp.br_image_off);
     BOOT_LOG_INF("Jumping to the first image slot");
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_BL2, BTL_CP_JUMP, 0);
     do_boot(&rsp);
 
     BOOT_LOG_ERR("Never should get here");
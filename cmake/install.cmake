@@ -42,6 +42,7 @@ install(FILES       ${CMAKE_SOURCE_DIR}/config/config_base.h
         DESTINATION ${INSTALL_INTERFACE_INC_DIR})
 
 install(FILES       ${INTERFACE_INC_DIR}/tfm_psa_call_pack.h
+                    ${INTERFACE_INC_DIR}/tfm_psa_call_batch.h
         DESTINATION ${INSTALL_INTERFACE_INC_DIR})
 install(FILES       ${CMAKE_BINARY_DIR}/generated/interface/include/psa/framework_feature.h
         DESTINATION ${INSTALL_INTERFACE_INC_DIR}/psa)
@@ -99,6 +100,12 @@ if(TFM_PARTITION_PLATFORM)
             DESTINATION ${INSTALL_INTERFACE_INC_DIR})
 endif()
 
+if(TFM_PARTITION_DIAGNOSTICS)
+    install(FILES       ${INTERFACE_INC_DIR}/tfm_diag_api.h
+                        ${INTERFACE_INC_DIR}/tfm_diag_defs.h
+            DESTINATION ${INSTALL_INTERFACE_INC_DIR})
+endif()
+
 if(TFM_PARTITION_FIRMWARE_UPDATE)
     install(FILES       ${INTERFACE_INC_DIR}/psa/update.h
                         ${CMAKE_BINARY_DIR}/generated/interface/include/psa/fwu_config.h
@@ -160,6 +167,11 @@ if(TFM_PARTITION_PLATFORM)
             DESTINATION ${INSTALL_INTERFACE_SRC_DIR})
 endif()
 
+if(TFM_PARTITION_DIAGNOSTICS)
+    install(FILES       ${INTERFACE_SRC_DIR}/tfm_diag_api.c
+            DESTINATION ${INSTALL_INTERFACE_SRC_DIR})
+endif()
+
 ##################### Export image signing information #########################
 
 if(BL2 AND PLATFORM_DEFAULT_IMAGE_SIGNING)
@@ -16,6 +16,8 @@ tfm_invalid_config(TFM_ISOLATION_LEVEL GREATER 1 AND PSA_FRAMEWORK_HAS_MM_IOVEC)
 tfm_invalid_config(TFM_MULTI_CORE_TOPOLOGY AND TFM_NS_MANAGE_NSID)
 tfm_invalid_config(TFM_PLAT_SPECIFIC_MULTI_CORE_COMM AND NOT TFM_MULTI_CORE_TOPOLOGY)
 tfm_invalid_config(TFM_ISOLATION_LEVEL EQUAL 3 AND CONFIG_TFM_STACK_WATERMARKS)
+tfm_invalid_config(TFM_PARTITION_DIAGNOSTICS AND NOT CONFIG_TFM_SPM_SERVICE_STATS)
+tfm_invalid_config(TFM_ISOLATION_LEVEL EQUAL 3 AND TFM_PARTITION_DIAGNOSTICS)
 
 tfm_invalid_config(CONFIG_TFM_LOG_SHARE_UART AND NOT SECURE_UART1)
 
@@ -72,6 +72,7 @@ set(TFM_MANIFEST_LIST                   ${CMAKE_SOURCE_DIR}/tools/tfm_manifest_l
 set(TFM_CODE_SHARING                    OFF         CACHE PATH      "Enable code sharing between MCUboot and secure firmware")
 set(CONFIG_TFM_BOOT_STORE_MEASUREMENTS  ON          CACHE BOOL      "Store measurement values from all the boot stages. Used for initial attestation token.")
 set(CONFIG_TFM_BOOT_STORE_ENCODED_MEASUREMENTS  ON  CACHE BOOL      "Enable storing of encoded measurements in boot.")
+set(CONFIG_TFM_BOOT_TIMELINE            OFF         CACHE BOOL      "Record timestamped checkpoints of all the boot stages into the shared boot data")
 
 set(TFM_PXN_ENABLE                      OFF         CACHE BOOL      "Use Privileged execute never (PXN)")
 
@@ -81,12 +82,18 @@ set(CONFIG_TFM_HALT_ON_CORE_PANIC       OFF         CACHE BOOL       "On fatal e
 
 set(CONFIG_TFM_STACK_WATERMARKS         OFF         CACHE BOOL      "Whether to pre-fill partition stacks with a set value to help determine stack usage")
 
+set(CONFIG_TFM_SPM_TRACE                OFF         CACHE BOOL      "Whether to record SPM events into a RAM ring buffer for timing analysis")
+
+set(CONFIG_TFM_SPM_SERVICE_STATS        OFF         CACHE BOOL      "Whether the SPM keeps per-service latency and throughput statistics")
+
 set(PROJECT_CONFIG_HEADER_FILE          "${CMAKE_SOURCE_DIR}/config/config_base.h" CACHE FILEPATH "User defined header file for TF-M config")
 
 set(CONFIG_TFM_LOG_SHARE_UART           OFF         CACHE BOOL      "Allow TF-M and the non-secure application to share the UART instance. TF-M will use it while it is booting, after which the non-secure application will use it until an eventual fatal error is handled and logged by TF-M. Logging from TF-M will therefore otherwise be suppressed")
 ############################ Platform ##########################################
 
 set(NUM_MAILBOX_QUEUE_SLOT              1           CACHE BOOL      "Number of mailbox queue slots")
+set(MAILBOX_RING_TRANSPORT              OFF         CACHE BOOL      "Whether the mailbox passes requests and replies through lock-free rings in shared memory instead of slot status bitmasks")
+set(NUM_MAILBOX_SHM_BUF                 0           CACHE STRING    "Number of shared payload buffers which NSPE can register to the mailbox. 0 disables the shared buffer pool")
 set(TFM_PLAT_SPECIFIC_MULTI_CORE_COMM   OFF         CACHE BOOL      "Whether to use a platform specific inter-core communication instead of mailbox in dual-cpu topology")
 
 set(DEBUG_AUTHENTICATION                CHIP_DEFAULT CACHE STRING   "Debug authentication setting. [CHIP_DEFAULT, NONE, NS_ONLY, FULL")
@@ -138,6 +145,7 @@ set(ATTEST_KEY_BITS                     256         CACHE STRING    "The size of
 set(PSA_INITIAL_ATTEST_MAX_TOKEN_SIZE   0x250       CACHE STRING    "The maximum possible size of a token")
 
 set(TFM_PARTITION_PLATFORM              OFF         CACHE BOOL      "Enable Platform partition")
+set(TFM_PARTITION_DIAGNOSTICS           OFF         CACHE BOOL      "Enable Diagnostics partition")
 
 ############################ Mbedcrypto configurations #########################
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2023, Arm Limited. All rights reserved.
  * Copyright (c) 2023 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -33,6 +33,13 @@
 #define PLATFORM_NV_COUNTER_MODULE_DISABLED    0
 #endif
 
+/* Diagnostics Partition Configs */
+
+/* The stack size of the Diagnostics Secure Partition */
+#ifndef DIAGNOSTICS_SP_STACK_SIZE
+#define DIAGNOSTICS_SP_STACK_SIZE              0x300
+#endif
+
 /* Crypto Partition Configs */
 
 /*
@@ -244,6 +251,16 @@
 #define NS_AGENT_MAILBOX_STACK_SIZE            0x800
 #endif
 
+/* The number of mailbox replies coalesced into one notification to NSPE */
+#ifndef CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM
+#define CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM  1
+#endif
+
+/* The deadline of coalesced mailbox replies in microseconds */
+#ifndef CONFIG_TFM_MAILBOX_REPLY_TIMEOUT_US
+#define CONFIG_TFM_MAILBOX_REPLY_TIMEOUT_US    100
+#endif
+
 /* SPM Partition Configs */
 
 #ifdef CONFIG_TFM_CONNECTION_POOL_ENABLE
@@ -253,11 +270,41 @@
 #endif
 #endif
 
+/* The maximal number of NS contexts, one per NS thread group */
+#ifndef CONFIG_TFM_NS_CONTEXT_MAX_NUM
+#define CONFIG_TFM_NS_CONTEXT_MAX_NUM           1
+#endif
+
+/* The maximal number of shared boot data TLVs indexed by the SPM */
+#ifndef CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM
+#define CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM      32
+#endif
+
+/* The maximal number of requests in one psa_call_batch() */
+#ifndef CONFIG_TFM_PSA_CALL_BATCH_MAX_NUM
+#define CONFIG_TFM_PSA_CALL_BATCH_MAX_NUM       8
+#endif
+
+/* Number of ranges cached by the memory check of the isolation HAL, 0 to disable */
+#ifndef CONFIG_TFM_HAL_MEM_CHECK_CACHE_NUM
+#define CONFIG_TFM_HAL_MEM_CHECK_CACHE_NUM      0
+#endif
+
 /* Disable the doorbell APIs */
 #ifndef CONFIG_TFM_DOORBELL_API
 #define CONFIG_TFM_DOORBELL_API                 0
 #endif
 
+/* Disable the asynchronous client APIs for Secure Partitions */
+#ifndef CONFIG_TFM_ASYNC_CALL_API
+#define CONFIG_TFM_ASYNC_CALL_API               0
+#endif
+
+/* Run the SFN partitions in their own threads only */
+#ifndef CONFIG_TFM_SFN_DIRECT_CALL
+#define CONFIG_TFM_SFN_DIRECT_CALL              0
+#endif
+
 /* Do not run the scheduler after handling a secure interrupt if the NSPE was pre-empted */
 #ifndef CONFIG_TFM_SCHEDULE_WHEN_NS_INTERRUPTED
 #define CONFIG_TFM_SCHEDULE_WHEN_NS_INTERRUPTED 0
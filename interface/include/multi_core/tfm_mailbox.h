@@ -22,6 +22,9 @@
 
 #include "psa/client.h"
 #include "tfm_mailbox_config.h"
+#ifdef MAILBOX_RING_TRANSPORT
+#include "cmsis_compiler.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,6 +37,40 @@ extern "C" {
 #define MAILBOX_PSA_CALL                    (0x4)
 #define MAILBOX_PSA_CLOSE                   (0x5)
 
+#define MAILBOX_CALL_TYPE_MASK              (0xFFUL)
+
+/*
+ * Flag ORed into the PSA client call type. SPE mailbox notifies NSPE of the
+ * reply at once, even if it coalesces the other reply notifications.
+ */
+#define MAILBOX_URGENT_REPLY                (1UL << 31)
+
+/*
+ * Flag ORed into MAILBOX_PSA_CALL. The vectors of the call are described by
+ * struct mailbox_shm_vec_t in the shared payload buffers.
+ */
+#define MAILBOX_SHM_VEC                     (1UL << 30)
+
+/*
+ * Priority of a PSA client call, ORed into the call type. Calls without a
+ * priority are normal ones.
+ */
+#define MAILBOX_PRIO_POS                    (8)
+#define MAILBOX_PRIO_MASK                   (0x3UL << MAILBOX_PRIO_POS)
+#define MAILBOX_PRIO_NORMAL                 (0x0UL << MAILBOX_PRIO_POS)
+#define MAILBOX_PRIO_HIGH                   (0x1UL << MAILBOX_PRIO_POS)
+#define MAILBOX_PRIO_LOW                    (0x2UL << MAILBOX_PRIO_POS)
+
+/* Priority lanes, served from lane 0 */
+#define MAILBOX_PRIO_LANE_HIGH              (0)
+#define MAILBOX_PRIO_LANE_NORMAL            (1)
+#define MAILBOX_PRIO_LANE_LOW               (2)
+#define MAILBOX_PRIO_LANE_NUM               (3)
+
+/* Access permissions of a shared payload buffer */
+#define MAILBOX_SHM_BUF_READ                (1UL << 0)
+#define MAILBOX_SHM_BUF_WRITE               (1UL << 1)
+
 /* Return code of mailbox APIs */
 #define MAILBOX_SUCCESS                     (0)
 #define MAILBOX_QUEUE_FULL                  (INT32_MIN + 1)
@@ -45,6 +82,27 @@ extern "C" {
 #define MAILBOX_INIT_ERROR                  (INT32_MIN + 7)
 #define MAILBOX_GENERIC_ERROR               (INT32_MIN + 8)
 
+#if NUM_MAILBOX_SHM_BUF > 0
+/*
+ * A shared payload buffer registered by NSPE at mailbox initialization.
+ * SPE validates it once and keeps a copy.
+ */
+struct mailbox_shm_buf_t {
+    void     *base;                 /* Base address of the buffer */
+    uint32_t size;                  /* Size of the buffer in bytes */
+    uint32_t access;                /* MAILBOX_SHM_BUF_READ and/or
+                                     * MAILBOX_SHM_BUF_WRITE
+                                     */
+};
+
+/* A PSA client call vector in a shared payload buffer */
+struct mailbox_shm_vec_t {
+    uint32_t buf_idx;               /* Index of the shared payload buffer */
+    uint32_t offset;                /* Offset of the payload in the buffer */
+    size_t   len;                   /* Length of the payload */
+};
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
+
 /*
  * This structure holds the parameters used in a PSA client call.
  */
@@ -71,6 +129,18 @@ struct psa_client_params_t {
         struct {
             psa_handle_t    handle;
         } psa_close_params;
+
+#if NUM_MAILBOX_SHM_BUF > 0
+        /* psa_call() with MAILBOX_SHM_VEC */
+        struct {
+            psa_handle_t                   handle;
+            int32_t                        type;
+            const struct mailbox_shm_vec_t *in_vec;
+            size_t                         in_len;
+            struct mailbox_shm_vec_t       *out_vec;
+            size_t                         out_len;
+        } psa_call_shm_params;
+#endif
     };
 };
 
@@ -99,17 +169,10 @@ struct mailbox_reply_t {
     int32_t    *reply;                      /* Address of reply value belonging
                                              * to owner task.
                                              */
-#ifdef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
-    uint8_t    *woken_flag;                 /* Indicate that owner task has been
-                                             * or should be woken up, after the
-                                             * reply is received.
-                                             */
-#else
     bool        is_woken;                   /* Indicate that owner task has been
                                              * or should be woken up, after the
                                              * reply is received.
                                              */
-#endif
 };
 
 /* A single slot structure in NSPE mailbox queue */
@@ -120,8 +183,39 @@ struct ns_mailbox_slot_t {
 
 typedef uint32_t   mailbox_queue_status_t;
 
+#ifdef MAILBOX_RING_TRANSPORT
+/*
+ * Single-producer single-consumer ring of mailbox queue slot indices.
+ * The ring has as many entries as the mailbox queue has slots. A slot is in
+ * at most one ring at a time, therefore a ring never overflows.
+ */
+struct mailbox_ring_t {
+    volatile uint32_t head;                     /* Free running index of the
+                                                 * next entry to write. Only
+                                                 * written by the producer.
+                                                 */
+    volatile uint32_t tail;                     /* Free running index of the
+                                                 * next entry to read. Only
+                                                 * written by the consumer.
+                                                 */
+    volatile uint8_t  slot_idx[NUM_MAILBOX_QUEUE_SLOT];
+};
+#endif /* MAILBOX_RING_TRANSPORT */
+
 /* NSPE mailbox queue */
 struct ns_mailbox_queue_t {
+#ifdef MAILBOX_RING_TRANSPORT
+    struct mailbox_ring_t    empty_ring;        /* Empty slots, only used
+                                                 * in NSPE
+                                                 */
+    struct mailbox_ring_t    pend_ring;         /* Slots pending for SPE
+                                                 * handling, from NSPE to SPE
+                                                 */
+    struct mailbox_ring_t    replied_ring;      /* Slots containing PSA client
+                                                 * call return result, from SPE
+                                                 * to NSPE
+                                                 */
+#else
     mailbox_queue_status_t   empty_slots;       /* Bitmask of empty slots */
     mailbox_queue_status_t   pend_slots;        /* Bitmask of slots pending
                                                  * for SPE handling
@@ -130,9 +224,21 @@ struct ns_mailbox_queue_t {
                                                  * containing PSA client call
                                                  * return result
                                                  */
+#endif /* MAILBOX_RING_TRANSPORT */
 
     struct ns_mailbox_slot_t queue[NUM_MAILBOX_QUEUE_SLOT];
 
+#if NUM_MAILBOX_SHM_BUF > 0
+    struct mailbox_shm_buf_t shm_buf[NUM_MAILBOX_SHM_BUF];
+                                                /* Shared payload buffers,
+                                                 * set up before SPE mailbox
+                                                 * initializes
+                                                 */
+    uint32_t                 nr_shm_buf;        /* The number of registered
+                                                 * shared payload buffers
+                                                 */
+#endif
+
 #ifdef TFM_MULTI_CORE_TEST
     uint32_t                 nr_tx;             /* The total number of
                                                  * submission of NS PSA Client
@@ -144,11 +250,108 @@ struct ns_mailbox_queue_t {
                                                  * NS thread requests a mailbox
                                                  * queue slot.
                                                  */
+    uint32_t                 nr_req_notify;     /* The total number of
+                                                 * notifications from NSPE to
+                                                 * SPE.
+                                                 */
+    uint32_t                 nr_reply_notify;   /* The total number of
+                                                 * notifications from SPE to
+                                                 * NSPE. Updated by SPE.
+                                                 */
+    uint32_t                 nr_reply_irq;      /* The total number of mailbox
+                                                 * IRQs handled in NSPE.
+                                                 */
 #endif
 
     bool                     is_full;           /* Queue if full */
 };
 
+/* Update the mailbox statistics only in multi-core tests */
+#ifdef TFM_MULTI_CORE_TEST
+#define MAILBOX_STATS_ADD(queue, field, val)    ((queue)->field += (val))
+#else
+#define MAILBOX_STATS_ADD(queue, field, val)
+#endif
+
+/**
+ * \brief Get the priority lane of a PSA client call.
+ *
+ * \param[in] call_type         PSA client call type with its flags.
+ *
+ * \return The lane, MAILBOX_PRIO_LANE_*.
+ */
+static inline uint8_t mailbox_prio_lane(uint32_t call_type)
+{
+    switch (call_type & MAILBOX_PRIO_MASK) {
+    case MAILBOX_PRIO_HIGH:
+        return MAILBOX_PRIO_LANE_HIGH;
+    case MAILBOX_PRIO_LOW:
+        return MAILBOX_PRIO_LANE_LOW;
+    default:
+        return MAILBOX_PRIO_LANE_NORMAL;
+    }
+}
+
+#ifdef MAILBOX_RING_TRANSPORT
+/**
+ * \brief Put a slot index into a ring. Only called by the producer.
+ *
+ * \param[in] ring              The ring.
+ * \param[in] idx               The slot index.
+ *
+ * \retval true                 The consumer had drained the ring and may be
+ *                              idle. The producer should notify it.
+ * \retval false                The consumer will find the entry without a
+ *                              notification.
+ */
+static inline bool mailbox_ring_put(struct mailbox_ring_t *ring, uint8_t idx)
+{
+    uint32_t head = ring->head;
+
+    ring->slot_idx[head & (NUM_MAILBOX_QUEUE_SLOT - 1)] = idx;
+
+    /* Publish the entry, and the slot content, before the new head */
+    __DMB();
+    ring->head = head + 1;
+
+    /* Pairs with the barrier in mailbox_ring_get() after the tail update */
+    __DMB();
+
+    return (ring->tail == head);
+}
+
+/**
+ * \brief Get a slot index from a ring. Only called by the consumer.
+ *
+ * \param[in]  ring             The ring.
+ * \param[out] idx              The slot index.
+ *
+ * \retval true                 A slot index is returned.
+ * \retval false                The ring is empty.
+ */
+static inline bool mailbox_ring_get(struct mailbox_ring_t *ring, uint8_t *idx)
+{
+    uint32_t tail = ring->tail;
+
+    if (ring->head == tail) {
+        return false;
+    }
+
+    /* Read the entry after the head which published it */
+    __DMB();
+    *idx = ring->slot_idx[tail & (NUM_MAILBOX_QUEUE_SLOT - 1)];
+
+    /* Release the entry only after it is read */
+    __DMB();
+    ring->tail = tail + 1;
+
+    /* Check the head again only after the tail update is visible */
+    __DMB();
+
+    return true;
+}
+#endif /* MAILBOX_RING_TRANSPORT */
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,26 @@ extern "C" {
 #error "NUM_MAILBOX_QUEUE_SLOT should be set to 1 for NS bare metal environment"
 #endif
 
+/*
+ * The number of extra polls of the replied mailbox messages in the mailbox IRQ
+ * handler. A busy NSPE can set it to drain several replies per IRQ, when SPE
+ * returns them in a burst or coalesces the notifications.
+ */
+#ifndef TFM_MULTI_CORE_NS_REPLY_POLL_NUM
+#define TFM_MULTI_CORE_NS_REPLY_POLL_NUM    0
+#endif
+
+#ifdef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+/*
+ * The maximum number of NS mailbox threads running
+ * tfm_ns_mailbox_thread_runner(). Several threads submit the PSA client calls
+ * of the application threads concurrently.
+ */
+#ifndef TFM_MULTI_CORE_NS_MAILBOX_RUNNER_NUM
+#define TFM_MULTI_CORE_NS_MAILBOX_RUNNER_NUM    1
+#endif
+#endif
+
 /**
  * \brief NSPE mailbox initialization
  *
@@ -34,11 +54,85 @@ extern "C" {
  */
 int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue);
 
+/**
+ * \brief psa_call() in a priority lane. SPE mailbox and the NS mailbox thread
+ *        serve the pending calls of a higher priority first.
+ *
+ * \param[in] prio              \ref MAILBOX_PRIO_HIGH, \ref MAILBOX_PRIO_NORMAL
+ *                              or \ref MAILBOX_PRIO_LOW.
+ * \param[in] handle            A handle to an established connection.
+ * \param[in] type              The request type.
+ * \param[in] in_vec            Array of input vectors.
+ * \param[in] in_len            Number of input vectors.
+ * \param[in,out] out_vec       Array of output vectors.
+ * \param[in] out_len           Number of output vectors.
+ *
+ * \return The status returned by psa_call().
+ */
+psa_status_t tfm_ns_mailbox_psa_call_prio(uint32_t prio,
+                                          psa_handle_t handle, int32_t type,
+                                          const psa_invec *in_vec,
+                                          size_t in_len,
+                                          psa_outvec *out_vec, size_t out_len);
+
+#if NUM_MAILBOX_SHM_BUF > 0
+/**
+ * \brief Register a shared payload buffer to the mailbox.
+ *
+ * \note  The buffers must be registered before \ref tfm_ns_mailbox_init().
+ *        SPE validates them once when the mailbox initializes and rejects the
+ *        PSA client calls referring to an invalid buffer.
+ *
+ * \param[in] base              Base address of the buffer.
+ * \param[in] size              Size of the buffer in bytes.
+ * \param[in] access            \ref MAILBOX_SHM_BUF_READ and/or
+ *                              \ref MAILBOX_SHM_BUF_WRITE.
+ * \param[out] buf_idx          The buffer index to set in
+ *                              struct mailbox_shm_vec_t.
+ *
+ * \retval MAILBOX_SUCCESS      The buffer is registered.
+ * \retval MAILBOX_INVAL_PARAMS Invalid parameters.
+ * \retval MAILBOX_INIT_ERROR   The mailbox is already initialized.
+ * \retval MAILBOX_QUEUE_FULL   All the NUM_MAILBOX_SHM_BUF buffers are
+ *                              registered.
+ */
+int32_t tfm_ns_mailbox_register_shm_buf(void *base, uint32_t size,
+                                        uint32_t access, uint32_t *buf_idx);
+
+/**
+ * \brief psa_call() with the vectors in the registered shared payload
+ *        buffers. SPE checks the vectors against the buffers validated at
+ *        initialization, instead of checking each memory range in each call.
+ *
+ * \param[in] handle            A handle to an established connection.
+ * \param[in] type              The request type.
+ * \param[in] in_vec            Array of input vectors in the shared buffers.
+ *                              The array itself must lie in a registered
+ *                              buffer readable by SPE.
+ * \param[in] in_len            Number of input vectors.
+ * \param[in,out] out_vec       Array of output vectors in the shared buffers.
+ *                              The lengths are updated with the written
+ *                              sizes, so the array itself must lie in a
+ *                              registered buffer writable by SPE.
+ * \param[in] out_len           Number of output vectors.
+ *
+ * \return The status returned by psa_call().
+ */
+psa_status_t tfm_ns_mailbox_psa_call_shm(psa_handle_t handle, int32_t type,
+                                        const struct mailbox_shm_vec_t *in_vec,
+                                        size_t in_len,
+                                        struct mailbox_shm_vec_t *out_vec,
+                                        size_t out_len);
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
+
 /**
  * \brief Send PSA client call to SPE via mailbox. Wait and fetch PSA client
  *        call result.
  *
- * \param[in] call_type         PSA client call type
+ * \param[in] call_type         PSA client call type, optionally ORed with
+ *                              \ref MAILBOX_URGENT_REPLY for a
+ *                              latency-critical call, and with a
+ *                              MAILBOX_PRIO_* priority.
  * \param[in] params            Parameters used for PSA client call
  * \param[in] client_id         Optional client ID of non-secure caller.
  *                              It is required to identify the non-secure caller
@@ -59,6 +153,10 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
  *        This function constructs NS mailbox messages, transmits them to SPE
  *        mailbox and returns the results to NS PSA client.
  *
+ * \note  Up to \ref TFM_MULTI_CORE_NS_MAILBOX_RUNNER_NUM NS mailbox threads
+ *        can run this function concurrently. It returns immediately in the
+ *        extra ones.
+ *
  * \param[in] args              The pointer to the structure of PSA client call
  *                              parameters.
  */
@@ -229,6 +327,10 @@ int32_t tfm_ns_mailbox_os_mq_receive(void *mq_handle, void *msg_ptr);
  *        This function is intended to be called inside platform specific
  *        notification IRQ handler.
  *
+ * \note  It polls the replied mailbox messages
+ *        \ref TFM_MULTI_CORE_NS_REPLY_POLL_NUM more times to handle the
+ *        replies returned right after.
+ *
  * \return MAILBOX_SUCCESS       The tasks of replied mailbox messages
  *                               were found and wake-up signals were sent.
  * \return MAILBOX_NO_PEND_EVENT No replied mailbox message is found.
@@ -286,6 +388,7 @@ static inline int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
 #define tfm_ns_mailbox_os_spin_unlock() do {} while (0)
 #endif /* TFM_MULTI_CORE_NS_OS */
 
+#ifndef MAILBOX_RING_TRANSPORT
 /* The following inline functions configure non-secure mailbox queue status */
 static inline void clear_queue_slot_empty(struct ns_mailbox_queue_t *queue_ptr,
                                           uint8_t idx)
@@ -309,6 +412,7 @@ static inline void clear_queue_slot_all_replied(
 {
     queue_ptr->replied_slots &= ~status;
 }
+#endif /* MAILBOX_RING_TRANSPORT */
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_DIAG_API_H__
+#define __TFM_DIAG_API_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "psa/client.h"
+#include "tfm_diag_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Read the statistics of the RoT Services.
+ *
+ * \param[in]  start            Index of the first service to read. Services
+ *                              are enumerated in the partition load order.
+ * \param[out] stats            Array to hold the statistics.
+ * \param[in]  max_count        Number of entries in \a stats.
+ * \param[out] count            Number of entries filled. It is less than
+ *                              \a max_count when the last service is reached.
+ *
+ * \return Returns values as specified by the \ref psa_status_t
+ */
+psa_status_t tfm_diag_get_service_stats(uint32_t start,
+                                        struct tfm_diag_service_stats_t *stats,
+                                        size_t max_count, size_t *count);
+
+/**
+ * \brief Clear the statistics of all RoT Services.
+ *
+ * \note  Only secure clients can clear the statistics.
+ *
+ * \return PSA_ERROR_NOT_PERMITTED if the client is non-secure, otherwise
+ *         values as specified by the \ref psa_status_t
+ */
+psa_status_t tfm_diag_reset_service_stats(void);
+
+/**
+ * \brief Read the usage of the SPM connection pool.
+ *
+ * \param[out] stats            Buffer to hold the statistics.
+ *
+ * \return PSA_ERROR_NOT_SUPPORTED if the SPM has no connection pool,
+ *         otherwise values as specified by the \ref psa_status_t
+ */
+psa_status_t tfm_diag_get_conn_pool_stats(
+                                    struct tfm_diag_conn_pool_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_DIAG_API_H__ */
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_DIAG_DEFS_H__
+#define __TFM_DIAG_DEFS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Request types of the diagnostics service */
+#define TFM_DIAG_API_ID_GET_SERVICE_STATS       (1001)
+#define TFM_DIAG_API_ID_RESET_SERVICE_STATS     (1002)
+#define TFM_DIAG_API_ID_GET_CONN_POOL_STATS     (1003)
+
+/*
+ * Running statistics of one RoT Service. The times are in SPM timestamp
+ * units, which are core cycles on cores with the DWT cycle counter.
+ *
+ * The service time is measured from psa_get() until psa_reply(). The queueing
+ * time is measured from the message delivery to the service until psa_get().
+ * SFN partitions get the message when it is delivered, so their queueing time
+ * is always 0.
+ */
+struct tfm_diag_service_stats_t {
+    uint32_t sid;                   /* Service ID                           */
+    uint32_t calls;                 /* Messages replied by the service      */
+    uint64_t service_cycles_total;  /* Sum of the service times             */
+    uint32_t service_cycles_max;    /* Longest service time                 */
+    uint32_t queue_cycles_max;      /* Longest queueing time                */
+    uint64_t queue_cycles_total;    /* Sum of the queueing times            */
+    uint64_t bytes_read;            /* Bytes read by psa_read()             */
+    uint64_t bytes_written;         /* Bytes written by psa_write()         */
+};
+
+/* Usage of the SPM connection pool */
+struct tfm_diag_conn_pool_stats_t {
+    uint32_t capacity;              /* Number of connection slots           */
+    uint32_t in_use;                /* Slots allocated now                  */
+    uint32_t high_water;            /* Most slots allocated at a time       */
+    uint32_t stale_handles;         /* Handles rejected as stale            */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_DIAG_DEFS_H__ */
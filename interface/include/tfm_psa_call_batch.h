@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_PSA_CALL_BATCH_H__
+#define __TFM_PSA_CALL_BATCH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "psa/client.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Descriptor of one request in a batch. */
+typedef struct psa_call_desc_t {
+    psa_handle_t handle;        /* Handle to the target service             */
+    int32_t type;               /* Request type, as for \ref psa_call       */
+    const psa_invec *in_vec;    /* Array of input psa_invec structures      */
+    size_t in_len;              /* Number of psa_invec structures           */
+    psa_outvec *out_vec;        /* Array of output psa_outvec structures    */
+    size_t out_len;             /* Number of psa_outvec structures          */
+    psa_status_t status;        /* [out] Status returned by this request    */
+} psa_call_desc_t;
+
+/**
+ * \brief Call several RoT Services in one request to the SPM.
+ *
+ * \details The requests are dispatched by the SPM in the array order, each
+ *          one after the previous has been replied. The status of every
+ *          request is written back to the \a status member of its descriptor.
+ *          A request which cannot be dispatched does not stop the batch, its
+ *          status reports the error instead.
+ *
+ * \note    On multi-core platforms the NSPE sends the requests one after
+ *          another through the mailbox.
+ *
+ * \param[in,out] calls         Array of request descriptors.
+ * \param[in] num_calls         Number of descriptors, must not exceed the
+ *                              batch size limit of the SPM.
+ *
+ * \retval PSA_SUCCESS          All the requests returned a non-negative
+ *                              status.
+ * \retval <0                   The negative status of one of the failing
+ *                              requests, check the status of each descriptor.
+ * \retval "PROGRAMMER ERROR"   The descriptor array is invalid or too large.
+ */
+psa_status_t psa_call_batch(psa_call_desc_t *calls, size_t num_calls);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_PSA_CALL_BATCH_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -9,6 +9,7 @@
 #define __TFM_PSA_CALL_PACK_H__
 
 #include "psa/client.h"
+#include "tfm_psa_call_batch.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,11 +69,26 @@ extern "C" {
 #define PARAM_HAS_IOVEC(ctrl_param)                                  \
           ((ctrl_param) != (uint32_t)PARAM_UNPACK_TYPE(ctrl_param))
 
+/*
+ * Control parameter of a batch: the number of descriptors in the low bits,
+ * NS_VEC_DESC_BIT set if the descriptors come from the non-secure client.
+ */
+#define BATCH_NUM_MASK       0xFFUL
+
+#define PARAM_PACK_BATCH(num)                                        \
+          (((uint32_t)(num)) & BATCH_NUM_MASK)
+
+#define PARAM_UNPACK_BATCH_NUM(ctrl_param)                           \
+          ((size_t)((ctrl_param) & BATCH_NUM_MASK))
+
 psa_status_t tfm_psa_call_pack(psa_handle_t handle,
                                uint32_t ctrl_param,
                                const psa_invec *in_vec,
                                psa_outvec *out_vec);
 
+psa_status_t tfm_psa_call_batch_pack(psa_call_desc_t *calls,
+                                     uint32_t ctrl_param);
+
 #ifdef __cplusplus
 }
 #endif
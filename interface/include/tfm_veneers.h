@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 #include "psa/client.h"
+#include "tfm_psa_call_batch.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -59,6 +60,17 @@ psa_status_t tfm_psa_call_veneer(psa_handle_t handle,
                                  const psa_invec *in_vec,
                                  psa_outvec *out_vec);
 
+/**
+ * \brief Call secure functions described by an array of descriptors.
+ *
+ * \param[in,out] calls         Array of \ref psa_call_desc_t descriptors.
+ * \param[in] ctrl_param        Number of descriptors.
+ *
+ * \return Returns \ref psa_status_t status code.
+ */
+psa_status_t tfm_psa_call_batch_veneer(psa_call_desc_t *calls,
+                                       uint32_t ctrl_param);
+
 /**
  * \brief Close connection to secure function referenced by a connection handle.
  *
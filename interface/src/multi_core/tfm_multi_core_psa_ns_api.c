@@ -13,6 +13,8 @@
 #include "psa/client.h"
 #include "psa/error.h"
 #include "tfm_ns_mailbox.h"
+#include "tfm_psa_call_batch.h"
+#include "tfm_psa_call_pack.h"
 
 /*
  * TODO
@@ -94,6 +96,16 @@ psa_handle_t psa_connect(uint32_t sid, uint32_t version)
 psa_status_t psa_call(psa_handle_t handle, int32_t type,
                       const psa_invec *in_vec, size_t in_len,
                       psa_outvec *out_vec, size_t out_len)
+{
+    return tfm_ns_mailbox_psa_call_prio(MAILBOX_PRIO_NORMAL, handle, type,
+                                        in_vec, in_len, out_vec, out_len);
+}
+
+psa_status_t tfm_ns_mailbox_psa_call_prio(uint32_t prio,
+                                          psa_handle_t handle, int32_t type,
+                                          const psa_invec *in_vec,
+                                          size_t in_len,
+                                          psa_outvec *out_vec, size_t out_len)
 {
     struct psa_client_params_t params;
     int32_t ret;
@@ -106,8 +118,64 @@ psa_status_t psa_call(psa_handle_t handle, int32_t type,
     params.psa_call_params.out_vec = out_vec;
     params.psa_call_params.out_len = out_len;
 
-    ret = tfm_ns_mailbox_client_call(MAILBOX_PSA_CALL, &params,
-                                     NON_SECURE_CLIENT_ID,
+    ret = tfm_ns_mailbox_client_call(MAILBOX_PSA_CALL |
+                                     (prio & MAILBOX_PRIO_MASK),
+                                     &params, NON_SECURE_CLIENT_ID,
+                                     (int32_t *)&status);
+    if (ret != MAILBOX_SUCCESS) {
+        status = PSA_INTER_CORE_COMM_ERR;
+    }
+
+    return status;
+}
+
+/*
+ * The mailbox has no batch message. The requests are sent one after another,
+ * so the batch saves no transition between the cores here.
+ */
+psa_status_t psa_call_batch(psa_call_desc_t *calls, size_t num_calls)
+{
+    psa_status_t batch_status = PSA_SUCCESS;
+    size_t i;
+
+    if ((num_calls > BATCH_NUM_MASK) ||
+        ((calls == NULL) && (num_calls != 0))) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    for (i = 0; i < num_calls; i++) {
+        calls[i].status = psa_call(calls[i].handle, calls[i].type,
+                                   calls[i].in_vec, calls[i].in_len,
+                                   calls[i].out_vec, calls[i].out_len);
+        if ((calls[i].status < PSA_SUCCESS) &&
+            (batch_status == PSA_SUCCESS)) {
+            batch_status = calls[i].status;
+        }
+    }
+
+    return batch_status;
+}
+
+#if NUM_MAILBOX_SHM_BUF > 0
+psa_status_t tfm_ns_mailbox_psa_call_shm(psa_handle_t handle, int32_t type,
+                                        const struct mailbox_shm_vec_t *in_vec,
+                                        size_t in_len,
+                                        struct mailbox_shm_vec_t *out_vec,
+                                        size_t out_len)
+{
+    struct psa_client_params_t params;
+    int32_t ret;
+    psa_status_t status;
+
+    params.psa_call_shm_params.handle = handle;
+    params.psa_call_shm_params.type = type;
+    params.psa_call_shm_params.in_vec = in_vec;
+    params.psa_call_shm_params.in_len = in_len;
+    params.psa_call_shm_params.out_vec = out_vec;
+    params.psa_call_shm_params.out_len = out_len;
+
+    ret = tfm_ns_mailbox_client_call(MAILBOX_PSA_CALL | MAILBOX_SHM_VEC,
+                                     &params, NON_SECURE_CLIENT_ID,
                                      (int32_t *)&status);
     if (ret != MAILBOX_SUCCESS) {
         status = PSA_INTER_CORE_COMM_ERR;
@@ -115,6 +183,7 @@ psa_status_t psa_call(psa_handle_t handle, int32_t type,
 
     return status;
 }
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
 
 void psa_close(psa_handle_t handle)
 {
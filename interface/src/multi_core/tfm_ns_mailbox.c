@@ -20,7 +20,12 @@ static int32_t mailbox_wait_reply(uint8_t idx);
 static inline void set_queue_slot_empty(uint8_t idx)
 {
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+#ifdef MAILBOX_RING_TRANSPORT
+        /* Under the spin lock, as several tasks release slots */
+        (void)mailbox_ring_put(&mailbox_queue_ptr->empty_ring, idx);
+#else
         mailbox_queue_ptr->empty_slots |= (1UL << idx);
+#endif
     }
 }
 
@@ -47,7 +52,7 @@ static inline void clear_queue_slot_woken(uint8_t idx)
     }
 }
 
-#ifndef TFM_MULTI_CORE_NS_OS
+#if !defined(TFM_MULTI_CORE_NS_OS) && !defined(MAILBOX_RING_TRANSPORT)
 static inline void clear_queue_slot_replied(uint8_t idx)
 {
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
@@ -63,34 +68,49 @@ static inline bool is_queue_slot_replied(uint8_t idx)
 
     return false;
 }
-#endif /* !defined TFM_MULTI_CORE_NS_OS */
+#endif /* !defined TFM_MULTI_CORE_NS_OS && !defined MAILBOX_RING_TRANSPORT */
 
+#ifdef MAILBOX_RING_TRANSPORT
 static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
 {
     uint8_t idx;
-    mailbox_queue_status_t status;
+    bool is_acquired;
 
+    /* Several tasks acquire slots, the spin lock keeps a single consumer */
     tfm_ns_mailbox_os_spin_lock();
-    status = queue->empty_slots;
+    is_acquired = mailbox_ring_get(&queue->empty_ring, &idx);
     tfm_ns_mailbox_os_spin_unlock();
 
-    if (!status) {
+    if (!is_acquired) {
         /* No empty slot */
         return NUM_MAILBOX_QUEUE_SLOT;
     }
 
+    return idx;
+}
+#else /* MAILBOX_RING_TRANSPORT */
+static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
+{
+    uint8_t idx;
+    mailbox_queue_status_t status;
+
+    /* Several tasks acquire slots, a slot is found and taken at once */
+    tfm_ns_mailbox_os_spin_lock();
+    status = queue->empty_slots;
+
     for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
         if (status & (1 << idx)) {
             break;
         }
     }
 
-    tfm_ns_mailbox_os_spin_lock();
+    /* NUM_MAILBOX_QUEUE_SLOT if no slot is empty */
     clear_queue_slot_empty(queue, idx);
     tfm_ns_mailbox_os_spin_unlock();
 
     return idx;
 }
+#endif /* MAILBOX_RING_TRANSPORT */
 
 static void set_msg_owner(uint8_t idx, const void *owner)
 {
@@ -107,6 +127,9 @@ static int32_t mailbox_tx_client_req(uint32_t call_type,
     uint8_t idx;
     struct mailbox_msg_t *msg_ptr;
     const void *task_handle;
+#ifdef MAILBOX_RING_TRANSPORT
+    bool need_notify;
+#endif
 
     idx = acquire_empty_slot(mailbox_queue_ptr);
     if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
@@ -131,11 +154,27 @@ static int32_t mailbox_tx_client_req(uint32_t call_type,
     task_handle = tfm_ns_mailbox_os_get_task_handle();
     set_msg_owner(idx, task_handle);
 
+#ifdef MAILBOX_RING_TRANSPORT
+    /* Several tasks submit requests, the spin lock keeps a single producer */
+    tfm_ns_mailbox_os_spin_lock();
+    need_notify = mailbox_ring_put(&mailbox_queue_ptr->pend_ring, idx);
+    if (need_notify) {
+        MAILBOX_STATS_ADD(mailbox_queue_ptr, nr_req_notify, 1);
+    }
+    tfm_ns_mailbox_os_spin_unlock();
+
+    /* SPE is still draining the ring otherwise */
+    if (need_notify) {
+        tfm_ns_mailbox_hal_notify_peer();
+    }
+#else
     tfm_ns_mailbox_hal_enter_critical();
     set_queue_slot_pend(mailbox_queue_ptr, idx);
+    MAILBOX_STATS_ADD(mailbox_queue_ptr, nr_req_notify, 1);
     tfm_ns_mailbox_hal_exit_critical();
 
     tfm_ns_mailbox_hal_notify_peer();
+#endif /* MAILBOX_RING_TRANSPORT */
 
     *slot_idx = idx;
 
@@ -205,22 +244,46 @@ exit:
 }
 
 #ifdef TFM_MULTI_CORE_NS_OS
-int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
+#ifdef MAILBOX_RING_TRANSPORT
+/* Wake up the owners of the replied slots. Returns false if none is found. */
+static bool mailbox_wake_reply_owners(void)
 {
     uint8_t idx;
-    mailbox_queue_status_t replied_status;
+    bool is_replied = false;
 
-    if (!mailbox_queue_ptr) {
-        return MAILBOX_INIT_ERROR;
+    /* The IRQ handler is the only consumer of the replied ring */
+    while (mailbox_ring_get(&mailbox_queue_ptr->replied_ring, &idx)) {
+        if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+            continue;
+        }
+
+        is_replied = true;
+
+        /* Set woken-up flag */
+        tfm_ns_mailbox_hal_enter_critical_isr();
+        set_queue_slot_woken(idx);
+        tfm_ns_mailbox_hal_exit_critical_isr();
+
+        tfm_ns_mailbox_os_wake_task_isr(
+                                     mailbox_queue_ptr->queue[idx].reply.owner);
     }
 
+    return is_replied;
+}
+#else /* MAILBOX_RING_TRANSPORT */
+/* Wake up the owners of the replied slots. Returns false if none is found. */
+static bool mailbox_wake_reply_owners(void)
+{
+    uint8_t idx;
+    mailbox_queue_status_t replied_status;
+
     tfm_ns_mailbox_hal_enter_critical_isr();
     replied_status = mailbox_queue_ptr->replied_slots;
     clear_queue_slot_all_replied(mailbox_queue_ptr, replied_status);
     tfm_ns_mailbox_hal_exit_critical_isr();
 
     if (!replied_status) {
-        return MAILBOX_NO_PEND_EVENT;
+        return false;
     }
 
     for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
@@ -246,6 +309,41 @@ int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
         }
     }
 
+    return true;
+}
+#endif /* MAILBOX_RING_TRANSPORT */
+
+int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
+{
+#if TFM_MULTI_CORE_NS_REPLY_POLL_NUM > 0
+    uint32_t nr_poll;
+#endif
+    bool is_replied;
+
+    if (!mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    MAILBOX_STATS_ADD(mailbox_queue_ptr, nr_reply_irq, 1);
+
+    is_replied = mailbox_wake_reply_owners();
+
+#if TFM_MULTI_CORE_NS_REPLY_POLL_NUM > 0
+    /*
+     * Poll for the replies which SPE returns right after, to handle a burst
+     * of replies in a single IRQ.
+     */
+    for (nr_poll = 0; nr_poll < TFM_MULTI_CORE_NS_REPLY_POLL_NUM; nr_poll++) {
+        if (mailbox_wake_reply_owners()) {
+            is_replied = true;
+        }
+    }
+#endif
+
+    if (!is_replied) {
+        return MAILBOX_NO_PEND_EVENT;
+    }
+
     return MAILBOX_SUCCESS;
 }
 
@@ -264,6 +362,18 @@ static inline bool mailbox_wait_reply_signal(uint8_t idx)
 
     return is_set;
 }
+#elif defined(MAILBOX_RING_TRANSPORT)
+static inline bool mailbox_wait_reply_signal(uint8_t idx)
+{
+    uint8_t replied_idx;
+
+    /* A single slot in NS bare metal environment */
+    if (mailbox_ring_get(&mailbox_queue_ptr->replied_ring, &replied_idx)) {
+        return (replied_idx == idx);
+    }
+
+    return false;
+}
 #else /* TFM_MULTI_CORE_NS_OS */
 static inline bool mailbox_wait_reply_signal(uint8_t idx)
 {
@@ -309,9 +419,43 @@ static int32_t mailbox_wait_reply(uint8_t idx)
     return MAILBOX_SUCCESS;
 }
 
+#if NUM_MAILBOX_SHM_BUF > 0
+/* Shared payload buffers registered before the mailbox initializes */
+static struct mailbox_shm_buf_t shm_buf[NUM_MAILBOX_SHM_BUF];
+static uint32_t nr_shm_buf = 0;
+
+int32_t tfm_ns_mailbox_register_shm_buf(void *base, uint32_t size,
+                                        uint32_t access, uint32_t *buf_idx)
+{
+    if (!base || !size || !buf_idx ||
+        !(access & (MAILBOX_SHM_BUF_READ | MAILBOX_SHM_BUF_WRITE))) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    /* SPE only reads the buffers at initialization */
+    if (mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    if (nr_shm_buf >= NUM_MAILBOX_SHM_BUF) {
+        return MAILBOX_QUEUE_FULL;
+    }
+
+    shm_buf[nr_shm_buf].base = base;
+    shm_buf[nr_shm_buf].size = size;
+    shm_buf[nr_shm_buf].access = access;
+    *buf_idx = nr_shm_buf++;
+
+    return MAILBOX_SUCCESS;
+}
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
+
 int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
 {
     int32_t ret;
+#ifdef MAILBOX_RING_TRANSPORT
+    uint8_t idx;
+#endif
 
     if (!queue) {
         return MAILBOX_INVAL_PARAMS;
@@ -324,11 +468,24 @@ int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
 
     memset(queue, 0, sizeof(*queue));
 
+#ifdef MAILBOX_RING_TRANSPORT
+    /* All the slots are empty */
+    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
+        queue->empty_ring.slot_idx[idx] = idx;
+    }
+    queue->empty_ring.head = NUM_MAILBOX_QUEUE_SLOT;
+#else
     /* Initialize empty bitmask */
     queue->empty_slots =
             (mailbox_queue_status_t)((1UL << (NUM_MAILBOX_QUEUE_SLOT - 1)) - 1);
     queue->empty_slots +=
             (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
+#endif /* MAILBOX_RING_TRANSPORT */
+
+#if NUM_MAILBOX_SHM_BUF > 0
+    memcpy(queue->shm_buf, shm_buf, sizeof(queue->shm_buf));
+    queue->nr_shm_buf = nr_shm_buf;
+#endif
 
     mailbox_queue_ptr = queue;
 
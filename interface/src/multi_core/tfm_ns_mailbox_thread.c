@@ -7,15 +7,19 @@
 
 #include <string.h>
 
+#include "cmsis_compiler.h"
 #include "tfm_ns_mailbox.h"
+#ifdef TFM_MULTI_CORE_TEST
+#include "tfm_ns_mailbox_test.h"
+#endif
 
-/* Thread woken up flag */
-#define NOT_WOKEN        0x0
-#define WOKEN_UP        0x5C
+/* Request completion state */
+#define REQ_PENDING      0x0
+#define REQ_COMPLETED    0x5C
 
 /*
  * The request contains the parameters which application threads share with
- * NS mailbox thread.
+ * NS mailbox threads.
  */
 struct ns_mailbox_req_t {
     uint32_t                         call_type;   /* PSA client call type */
@@ -33,81 +37,170 @@ struct ns_mailbox_req_t {
     int32_t                          *reply;      /* Address of reply value
                                                    * belonging to owner task.
                                                    */
-
-    uint8_t                          *woken_flag; /* Indicate that owner task
-                                                   * has been or should be woken
-                                                   * up, after the reply is
-                                                   * received.
+    volatile uint8_t                 state;       /* Set to REQ_COMPLETED by
+                                                   * the mailbox IRQ handler
+                                                   * after the reply is
+                                                   * written.
                                                    */
+    struct ns_mailbox_req_t          *next;       /* Next request in the same
+                                                   * priority lane.
+                                                   */
+};
+
+/* Requests waiting for the NS mailbox threads in a priority lane */
+struct ns_mailbox_req_lane_t {
+    struct ns_mailbox_req_t *head;
+    struct ns_mailbox_req_t *tail;
 };
 
+/* A NS mailbox thread running tfm_ns_mailbox_thread_runner() */
+struct ns_mailbox_runner_t {
+    const void    *handle;      /* Handle of the NS mailbox thread */
+    volatile bool is_waiting;   /* Waiting for a free mailbox queue slot */
+};
+
+/*
+ * The requests are queued in their priority lanes. The message queue only
+ * carries one token per request to wake up a NS mailbox thread, which then
+ * serves the highest priority lane first.
+ */
+static struct ns_mailbox_req_lane_t req_lanes[MAILBOX_PRIO_LANE_NUM];
+
+/*
+ * The requests left queued without a token, see tfm_ns_mailbox_client_call().
+ * The NS mailbox threads take these before waiting for the next token.
+ */
+static uint32_t nr_owed_tokens = 0;
+
 /* Message queue handle */
 static void *msgq_handle = NULL;
 
-/* The handle of the dedicated NS mailbox thread. */
-static const void *ns_mailbox_thread_handle = NULL;
+/* The NS mailbox threads */
+static struct ns_mailbox_runner_t runners[TFM_MULTI_CORE_NS_MAILBOX_RUNNER_NUM];
+static uint8_t nr_runners = 0;
+
+/*
+ * The request in flight in each mailbox queue slot. The mailbox IRQ handler
+ * completes it from NSPE local memory, rather than from the owner and reply
+ * addresses in the queue shared with SPE.
+ */
+static struct ns_mailbox_req_t *slot_reqs[NUM_MAILBOX_QUEUE_SLOT];
+
+/*
+ * Free mailbox queue slots, kept locally as the NS mailbox threads allocate
+ * them concurrently. Slot (n * 32 + i) is the bit (31 - i) of word n, so that
+ * CLZ returns the lowest free slot of a word.
+ */
+#define SLOT_MASK_WORDS         ((NUM_MAILBOX_QUEUE_SLOT + 31) / 32)
+#define SLOT_MASK_BIT(idx)      (0x80000000UL >> ((idx) % 32))
+
+static volatile uint32_t free_slot_mask[SLOT_MASK_WORDS];
 
 /* The pointer to NSPE mailbox queue */
 static struct ns_mailbox_queue_t *mailbox_queue_ptr = NULL;
 
-static inline void set_queue_slot_all_empty(mailbox_queue_status_t completed)
+/*
+ * Replace the value at addr with new_val if it still equals old_val.
+ * Returns false if it has changed, or the exclusive access is interrupted.
+ */
+static bool mailbox_cmp_swap(volatile uint32_t *addr, uint32_t old_val,
+                             uint32_t new_val)
 {
-    mailbox_queue_ptr->empty_slots |= completed;
+#if defined(__ARM_FEATURE_LDREX) && (__ARM_FEATURE_LDREX & 0x4)
+    if (__LDREXW(addr) != old_val) {
+        __CLREX();
+        return false;
+    }
+
+    return (__STREXW(new_val, addr) == 0U);
+#else
+    /* No exclusive access, such as on Armv6-M. Mask the interrupts instead. */
+    uint32_t primask = __get_PRIMASK();
+    bool is_swapped = false;
+
+    __disable_irq();
+    if (*addr == old_val) {
+        *addr = new_val;
+        is_swapped = true;
+    }
+    __set_PRIMASK(primask);
+
+    return is_swapped;
+#endif
 }
 
-static inline void set_queue_slot_woken(uint8_t idx)
+/* Returns NUM_MAILBOX_QUEUE_SLOT if no slot is free */
+static uint8_t alloc_free_slot(void)
 {
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        *mailbox_queue_ptr->queue[idx].reply.woken_flag = WOKEN_UP;
+    uint32_t word, pos;
+    uint8_t n;
+
+    for (n = 0; n < SLOT_MASK_WORDS; n++) {
+        do {
+            word = free_slot_mask[n];
+            if (!word) {
+                break;
+            }
+
+            pos = __CLZ(word);
+        } while (!mailbox_cmp_swap(&free_slot_mask[n], word,
+                                   word & ~(0x80000000UL >> pos)));
+
+        if (word) {
+            return (uint8_t)(n * 32 + pos);
+        }
     }
+
+    return NUM_MAILBOX_QUEUE_SLOT;
 }
 
-static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
+/* Called by the mailbox IRQ handler */
+static void release_slot(uint8_t idx)
 {
-    uint8_t idx;
-    mailbox_queue_status_t status;
+    volatile uint32_t *mask = &free_slot_mask[idx / 32];
+    uint32_t word;
 
-    while (1) {
-        tfm_ns_mailbox_os_spin_lock();
-        status = queue->empty_slots;
-        tfm_ns_mailbox_os_spin_unlock();
+    do {
+        word = *mask;
+    } while (!mailbox_cmp_swap(mask, word, word | SLOT_MASK_BIT(idx)));
+}
 
-        if (status) {
-            break;
-        }
+static uint8_t acquire_empty_slot(struct ns_mailbox_runner_t *runner)
+{
+    uint8_t idx;
 
+    idx = alloc_free_slot();
+    while (idx == NUM_MAILBOX_QUEUE_SLOT) {
         /* No empty slot */
-        queue->is_full = true;
+        runner->is_waiting = true;
         /* DSB to make sure the thread sleeps after the flag is set */
         __DSB();
 
-        /* Wait for an empty slot released by a completed mailbox message */
-        tfm_ns_mailbox_os_wait_reply();
-        queue->is_full = false;
-    }
-
-    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
-        if (status & (1 << idx)) {
-            break;
+        /* A slot may have been released before the flag is set */
+        idx = alloc_free_slot();
+        if (idx == NUM_MAILBOX_QUEUE_SLOT) {
+            /* Wait for an empty slot released by a completed message */
+            tfm_ns_mailbox_os_wait_reply();
+            idx = alloc_free_slot();
         }
-    }
 
-    tfm_ns_mailbox_os_spin_lock();
-    clear_queue_slot_empty(queue, idx);
-    tfm_ns_mailbox_os_spin_unlock();
+        runner->is_waiting = false;
+    }
 
     return idx;
 }
 
-static int32_t mailbox_tx_client_call_msg(const struct ns_mailbox_req_t *req,
-                                          uint8_t *slot_idx)
+static int32_t mailbox_tx_client_call_msg(struct ns_mailbox_runner_t *runner,
+                                          struct ns_mailbox_req_t *req)
 {
     struct mailbox_msg_t *msg_ptr;
-    struct mailbox_reply_t *reply_ptr;
-    uint8_t idx = NUM_MAILBOX_QUEUE_SLOT;
+    uint8_t idx;
+#ifdef MAILBOX_RING_TRANSPORT
+    bool need_notify;
+#endif
 
-    idx = acquire_empty_slot(mailbox_queue_ptr);
-    if (idx == NUM_MAILBOX_QUEUE_SLOT) {
+    idx = acquire_empty_slot(runner);
+    if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
         return MAILBOX_QUEUE_FULL;
     }
 
@@ -121,47 +214,162 @@ static int32_t mailbox_tx_client_call_msg(const struct ns_mailbox_req_t *req,
     memcpy(&msg_ptr->params, req->params_ptr, sizeof(msg_ptr->params));
     msg_ptr->client_id = req->client_id;
 
-    /* Prepare the reply structure */
-    reply_ptr = &mailbox_queue_ptr->queue[idx].reply;
-    reply_ptr->owner = req->owner;
-    reply_ptr->reply = req->reply;
-    reply_ptr->woken_flag = req->woken_flag;
+    /* The slot is owned by this thread until the reply arrives */
+    slot_reqs[idx] = req;
 
     /*
      * Memory check can be added here to prevent a malicious application
      * from providing addresses of other applications or privileged area.
      */
 
+#ifdef MAILBOX_RING_TRANSPORT
+    /*
+     * Several NS mailbox threads submit requests, the spin lock keeps a single
+     * producer. SPE is still draining the ring if it does not need a
+     * notification, so a burst of requests raises a single notification.
+     */
+    tfm_ns_mailbox_os_spin_lock();
+    need_notify = mailbox_ring_put(&mailbox_queue_ptr->pend_ring, idx);
+    if (need_notify) {
+        MAILBOX_STATS_ADD(mailbox_queue_ptr, nr_req_notify, 1);
+    }
+    tfm_ns_mailbox_os_spin_unlock();
+
+    if (need_notify) {
+        tfm_ns_mailbox_hal_notify_peer();
+    }
+#else
     tfm_ns_mailbox_hal_enter_critical();
     set_queue_slot_pend(mailbox_queue_ptr, idx);
+    MAILBOX_STATS_ADD(mailbox_queue_ptr, nr_req_notify, 1);
     tfm_ns_mailbox_hal_exit_critical();
 
     tfm_ns_mailbox_hal_notify_peer();
+#endif /* MAILBOX_RING_TRANSPORT */
+
+    return MAILBOX_SUCCESS;
+}
 
-    if (slot_idx) {
-        *slot_idx = idx;
+/* Return the result of a replied slot and wake up the owner of the request */
+static void mailbox_complete_slot_isr(uint8_t idx)
+{
+    struct ns_mailbox_req_t *req = slot_reqs[idx];
+    const void *task_handle;
+
+    slot_reqs[idx] = NULL;
+    if (!req) {
+        return;
     }
 
-    return MAILBOX_SUCCESS;
+    /* The request is released once completed, read it before */
+    task_handle = req->owner;
+
+    *req->reply = mailbox_queue_ptr->queue[idx].reply.return_val;
+    req->state = REQ_COMPLETED;
+
+    if (task_handle) {
+        tfm_ns_mailbox_os_wake_task_isr(task_handle);
+    }
 }
 
-static inline void ns_mailbox_set_reply_isr(uint8_t idx)
+static void mailbox_req_enqueue(struct ns_mailbox_req_t *req, uint8_t lane)
 {
-    int32_t *reply_ptr = mailbox_queue_ptr->queue[idx].reply.reply;
+    struct ns_mailbox_req_lane_t *req_lane = &req_lanes[lane];
+
+    req->next = NULL;
 
-    if (reply_ptr) {
-        *reply_ptr = mailbox_queue_ptr->queue[idx].reply.return_val;
+    tfm_ns_mailbox_os_spin_lock();
+    if (req_lane->tail) {
+        req_lane->tail->next = req;
+    } else {
+        req_lane->head = req;
     }
+    req_lane->tail = req;
+    tfm_ns_mailbox_os_spin_unlock();
+}
+
+/*
+ * Remove a request whose token cannot be sent. Returns false if a NS mailbox
+ * thread has already taken the request with the token of another request. That
+ * other request is owed a token then.
+ */
+static bool mailbox_req_remove(struct ns_mailbox_req_t *req, uint8_t lane)
+{
+    struct ns_mailbox_req_lane_t *req_lane = &req_lanes[lane];
+    struct ns_mailbox_req_t *prev = NULL, *curr;
+
+    tfm_ns_mailbox_os_spin_lock();
+    for (curr = req_lane->head; curr; prev = curr, curr = curr->next) {
+        if (curr != req) {
+            continue;
+        }
+
+        if (prev) {
+            prev->next = curr->next;
+        } else {
+            req_lane->head = curr->next;
+        }
+        if (req_lane->tail == curr) {
+            req_lane->tail = prev;
+        }
+        break;
+    }
+    if (!curr) {
+        nr_owed_tokens++;
+    }
+    tfm_ns_mailbox_os_spin_unlock();
+
+    return (curr != NULL);
+}
+
+static bool mailbox_take_owed_token(void)
+{
+    bool is_taken = false;
+
+    tfm_ns_mailbox_os_spin_lock();
+    if (nr_owed_tokens) {
+        nr_owed_tokens--;
+        is_taken = true;
+    }
+    tfm_ns_mailbox_os_spin_unlock();
+
+    return is_taken;
+}
+
+/* Take the oldest request of the highest priority lane */
+static struct ns_mailbox_req_t *mailbox_req_dequeue(void)
+{
+    struct ns_mailbox_req_lane_t *req_lane;
+    struct ns_mailbox_req_t *req = NULL;
+    uint8_t lane;
+
+    tfm_ns_mailbox_os_spin_lock();
+    for (lane = 0; lane < MAILBOX_PRIO_LANE_NUM; lane++) {
+        req_lane = &req_lanes[lane];
+        if (!req_lane->head) {
+            continue;
+        }
+
+        req = req_lane->head;
+        req_lane->head = req->next;
+        if (!req_lane->head) {
+            req_lane->tail = NULL;
+        }
+        break;
+    }
+    tfm_ns_mailbox_os_spin_unlock();
+
+    return req;
 }
 
 static int32_t mailbox_wait_reply(const struct ns_mailbox_req_t *req)
 {
     while (1) {
         /*
-         * Check the completed flag to make sure that the current thread is
+         * Check the completion state to make sure that the current thread is
          * woken up by reply event, rather than other events.
          */
-        if (*req->woken_flag == WOKEN_UP) {
+        if (req->state == REQ_COMPLETED) {
             break;
         }
 
@@ -178,7 +386,7 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
                                    int32_t *reply)
 {
     struct ns_mailbox_req_t req;
-    uint8_t woken_flag = NOT_WOKEN;
+    uint8_t lane;
     int32_t ret;
 
     if (!mailbox_queue_ptr) {
@@ -192,13 +400,31 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
     req.call_type = call_type;
     req.params_ptr = params;
     req.reply = reply;
-    req.woken_flag = &woken_flag;
+    req.state = REQ_PENDING;
     req.owner = tfm_ns_mailbox_os_get_task_handle();
     req.client_id = client_id;
 
-    ret = tfm_ns_mailbox_os_mq_send(msgq_handle, &req);
+    lane = mailbox_prio_lane(call_type);
+    mailbox_req_enqueue(&req, lane);
+
+    ret = tfm_ns_mailbox_os_mq_send(msgq_handle, &lane);
     if (ret != MAILBOX_SUCCESS) {
-        return ret;
+        if (mailbox_req_remove(&req, lane)) {
+            return ret;
+        }
+
+        /*
+         * A NS mailbox thread has taken the request with the token of another
+         * request, which is now owed a token. The NS mailbox threads may all
+         * have drained the message queue and be waiting before the token was
+         * owed, so send it once more. If it is sent, the owed one is not needed
+         * any more, and a thread taking it anyway finds no request. If the
+         * message queue is full again, the threads take the owed token after
+         * the queued ones.
+         */
+        if (tfm_ns_mailbox_os_mq_send(msgq_handle, &lane) == MAILBOX_SUCCESS) {
+            (void)mailbox_take_owed_token();
+        }
     }
 
     ret = mailbox_wait_reply(&req);
@@ -208,16 +434,41 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
 
 void tfm_ns_mailbox_thread_runner(void *args)
 {
-    struct ns_mailbox_req_t req;
+    struct ns_mailbox_runner_t *runner = NULL;
+    struct ns_mailbox_req_t *req;
+    uint8_t lane;
     int32_t ret;
 
     (void)args;
 
-    ns_mailbox_thread_handle = tfm_ns_mailbox_os_get_task_handle();
+    tfm_ns_mailbox_os_spin_lock();
+    if (nr_runners < TFM_MULTI_CORE_NS_MAILBOX_RUNNER_NUM) {
+        runner = &runners[nr_runners];
+        runner->handle = tfm_ns_mailbox_os_get_task_handle();
+        runner->is_waiting = false;
+        nr_runners++;
+    }
+    tfm_ns_mailbox_os_spin_unlock();
+
+    /*
+     * More NS mailbox threads than TFM_MULTI_CORE_NS_MAILBOX_RUNNER_NUM could
+     * never be woken up when waiting for an empty slot.
+     */
+    if (!runner) {
+        return;
+    }
 
     while (1) {
-        ret = tfm_ns_mailbox_os_mq_receive(msgq_handle, &req);
-        if (ret != MAILBOX_SUCCESS) {
+        /* A token per request. The request served is not its own one. */
+        if (!mailbox_take_owed_token()) {
+            ret = tfm_ns_mailbox_os_mq_receive(msgq_handle, &lane);
+            if (ret != MAILBOX_SUCCESS) {
+                continue;
+            }
+        }
+
+        req = mailbox_req_dequeue();
+        if (!req) {
             continue;
         }
 
@@ -226,31 +477,55 @@ void tfm_ns_mailbox_thread_runner(void *args)
          * checked previously and therefore just simply ignore this
          * client call request.
          */
-        if (!req.params_ptr || !req.reply || !req.woken_flag) {
+        if (!req->params_ptr || !req->reply) {
             continue;
         }
 
-        mailbox_tx_client_call_msg(&req, NULL);
+        mailbox_tx_client_call_msg(runner, req);
     }
 }
 
-int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
+#ifdef MAILBOX_RING_TRANSPORT
+/*
+ * Return the results and wake up the owners of the replied slots.
+ * Returns false if none is found.
+ */
+static bool mailbox_wake_reply_owners(void)
 {
     uint8_t idx;
-    const void *task_handle;
-    mailbox_queue_status_t replied_status, complete_slots = 0x0;
+    bool is_replied = false;
 
-    if (!mailbox_queue_ptr) {
-        return MAILBOX_INIT_ERROR;
+    /* The IRQ handler is the only consumer of the replied ring */
+    while (mailbox_ring_get(&mailbox_queue_ptr->replied_ring, &idx)) {
+        if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+            continue;
+        }
+
+        is_replied = true;
+
+        mailbox_complete_slot_isr(idx);
+        release_slot(idx);
     }
 
+    return is_replied;
+}
+#else /* MAILBOX_RING_TRANSPORT */
+/*
+ * Return the results and wake up the owners of the replied slots.
+ * Returns false if none is found.
+ */
+static bool mailbox_wake_reply_owners(void)
+{
+    uint8_t idx;
+    mailbox_queue_status_t replied_status;
+
     tfm_ns_mailbox_hal_enter_critical_isr();
     replied_status = mailbox_queue_ptr->replied_slots;
     clear_queue_slot_all_replied(mailbox_queue_ptr, replied_status);
     tfm_ns_mailbox_hal_exit_critical_isr();
 
     if (!replied_status) {
-        return MAILBOX_NO_PEND_EVENT;
+        return false;
     }
 
     for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
@@ -262,25 +537,8 @@ int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
             continue;
         }
 
-        /*
-         * Write back the return result.
-         * When TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD is enabled, a reply is
-         * returned inside ns_mailbox_set_reply_isr().
-         * When TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD is disabled, a reply is
-         * returned inside mailbox_rx_client_reply(). ns_mailbox_set_reply_isr()
-         * is defined as dummy function.
-         */
-        ns_mailbox_set_reply_isr(idx);
-
-        /* Wake up the owner of this mailbox message */
-        set_queue_slot_woken(idx);
-
-        task_handle = mailbox_queue_ptr->queue[idx].reply.owner;
-        if (task_handle) {
-            tfm_ns_mailbox_os_wake_task_isr(task_handle);
-        }
-
-        complete_slots |= (1UL << idx);
+        mailbox_complete_slot_isr(idx);
+        release_slot(idx);
 
         replied_status &= ~(0x1UL << idx);
         if (!replied_status) {
@@ -288,15 +546,49 @@ int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
         }
     }
 
-    set_queue_slot_all_empty(complete_slots);
+    return true;
+}
+#endif /* MAILBOX_RING_TRANSPORT */
+
+int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
+{
+#if TFM_MULTI_CORE_NS_REPLY_POLL_NUM > 0
+    uint32_t nr_poll;
+#endif
+    bool is_replied;
+    uint8_t i;
+
+    if (!mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    MAILBOX_STATS_ADD(mailbox_queue_ptr, nr_reply_irq, 1);
+
+    is_replied = mailbox_wake_reply_owners();
+
+#if TFM_MULTI_CORE_NS_REPLY_POLL_NUM > 0
+    /*
+     * Poll for the replies which SPE returns right after, to handle a burst
+     * of replies in a single IRQ.
+     */
+    for (nr_poll = 0; nr_poll < TFM_MULTI_CORE_NS_REPLY_POLL_NUM; nr_poll++) {
+        if (mailbox_wake_reply_owners()) {
+            is_replied = true;
+        }
+    }
+#endif
+
+    if (!is_replied) {
+        return MAILBOX_NO_PEND_EVENT;
+    }
 
     /*
-     * Wake up the NS mailbox thread in case it is waiting for
-     * empty slots.
+     * Wake up the NS mailbox threads which are waiting for empty slots. The
+     * first ones to run take the released slots, the others wait again.
      */
-    if (mailbox_queue_ptr->is_full) {
-        if (ns_mailbox_thread_handle) {
-            tfm_ns_mailbox_os_wake_task_isr(ns_mailbox_thread_handle);
+    for (i = 0; i < nr_runners; i++) {
+        if (runners[i].is_waiting) {
+            tfm_ns_mailbox_os_wake_task_isr(runners[i].handle);
         }
     }
 
@@ -305,8 +597,7 @@ int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
 
 static inline int32_t mailbox_req_queue_init(uint8_t queue_depth)
 {
-    msgq_handle = tfm_ns_mailbox_os_mq_create(sizeof(struct ns_mailbox_req_t),
-                                              queue_depth);
+    msgq_handle = tfm_ns_mailbox_os_mq_create(sizeof(uint8_t), queue_depth);
     if (!msgq_handle) {
         return MAILBOX_GENERIC_ERROR;
     }
@@ -314,9 +605,41 @@ static inline int32_t mailbox_req_queue_init(uint8_t queue_depth)
     return MAILBOX_SUCCESS;
 }
 
+#if NUM_MAILBOX_SHM_BUF > 0
+/* Shared payload buffers registered before the mailbox initializes */
+static struct mailbox_shm_buf_t shm_buf[NUM_MAILBOX_SHM_BUF];
+static uint32_t nr_shm_buf = 0;
+
+int32_t tfm_ns_mailbox_register_shm_buf(void *base, uint32_t size,
+                                        uint32_t access, uint32_t *buf_idx)
+{
+    if (!base || !size || !buf_idx ||
+        !(access & (MAILBOX_SHM_BUF_READ | MAILBOX_SHM_BUF_WRITE))) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    /* SPE only reads the buffers at initialization */
+    if (mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    if (nr_shm_buf >= NUM_MAILBOX_SHM_BUF) {
+        return MAILBOX_QUEUE_FULL;
+    }
+
+    shm_buf[nr_shm_buf].base = base;
+    shm_buf[nr_shm_buf].size = size;
+    shm_buf[nr_shm_buf].access = access;
+    *buf_idx = nr_shm_buf++;
+
+    return MAILBOX_SUCCESS;
+}
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
+
 int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
 {
     int32_t ret;
+    uint8_t idx;
 
     if (!queue) {
         return MAILBOX_INVAL_PARAMS;
@@ -329,11 +652,18 @@ int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
 
     memset(queue, 0, sizeof(*queue));
 
-    /* Initialize empty bitmask */
-    queue->empty_slots =
-            (mailbox_queue_status_t)((1UL << (NUM_MAILBOX_QUEUE_SLOT - 1)) - 1);
-    queue->empty_slots +=
-            (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
+    /*
+     * All the slots are empty. The empty slots of the queue are not used, as
+     * NS mailbox threads allocate the slots from the local free mask.
+     */
+    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
+        free_slot_mask[idx / 32] |= SLOT_MASK_BIT(idx);
+    }
+
+#if NUM_MAILBOX_SHM_BUF > 0
+    memcpy(queue->shm_buf, shm_buf, sizeof(queue->shm_buf));
+    queue->nr_shm_buf = nr_shm_buf;
+#endif
 
     mailbox_queue_ptr = queue;
 
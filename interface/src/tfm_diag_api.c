@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "tfm_diag_api.h"
+#include "psa/client.h"
+#include "psa_manifest/sid.h"
+
+psa_status_t tfm_diag_get_service_stats(uint32_t start,
+                                        struct tfm_diag_service_stats_t *stats,
+                                        size_t max_count, size_t *count)
+{
+    psa_status_t status;
+    psa_invec in_vec[] = {
+        {.base = &start, .len = sizeof(start)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = stats, .len = max_count * sizeof(*stats)},
+    };
+
+    if (count == NULL) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = psa_call(TFM_DIAGNOSTICS_SERVICE_HANDLE,
+                      TFM_DIAG_API_ID_GET_SERVICE_STATS,
+                      in_vec, IOVEC_LEN(in_vec),
+                      out_vec, IOVEC_LEN(out_vec));
+    if (status == PSA_SUCCESS) {
+        *count = out_vec[0].len / sizeof(*stats);
+    }
+
+    return status;
+}
+
+psa_status_t tfm_diag_reset_service_stats(void)
+{
+    return psa_call(TFM_DIAGNOSTICS_SERVICE_HANDLE,
+                    TFM_DIAG_API_ID_RESET_SERVICE_STATS,
+                    NULL, 0, NULL, 0);
+}
+
+psa_status_t tfm_diag_get_conn_pool_stats(
+                                    struct tfm_diag_conn_pool_stats_t *stats)
+{
+    psa_outvec out_vec[] = {
+        {.base = stats, .len = sizeof(*stats)},
+    };
+
+    return psa_call(TFM_DIAGNOSTICS_SERVICE_HANDLE,
+                    TFM_DIAG_API_ID_GET_CONN_POOL_STATS,
+                    NULL, 0, out_vec, IOVEC_LEN(out_vec));
+}
@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include "psa/client.h"
 #include "psa/service.h"
+#include "tfm_psa_call_batch.h"
 #include "tfm_psa_call_pack.h"
 
 psa_status_t psa_call(psa_handle_t handle,
@@ -27,3 +28,16 @@ psa_status_t psa_call(psa_handle_t handle,
     return tfm_psa_call_pack(handle, PARAM_PACK(type, in_len, out_len),
                              in_vec, out_vec);
 }
+
+psa_status_t psa_call_batch(psa_call_desc_t *calls, size_t num_calls)
+{
+    if (num_calls == 0) {
+        return PSA_SUCCESS;
+    }
+
+    if (num_calls > BATCH_NUM_MASK) {
+        psa_panic();
+    }
+
+    return tfm_psa_call_batch_pack(calls, PARAM_PACK_BATCH(num_calls));
+}
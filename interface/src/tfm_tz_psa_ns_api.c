@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -7,6 +7,7 @@
 
 #include "psa/client.h"
 #include "tfm_ns_interface.h"
+#include "tfm_psa_call_batch.h"
 #include "tfm_psa_call_pack.h"
 
 /**** API functions ****/
@@ -52,6 +53,24 @@ psa_status_t psa_call(psa_handle_t handle, int32_t type,
                                 (uint32_t)out_vec);
 }
 
+psa_status_t psa_call_batch(psa_call_desc_t *calls, size_t num_calls)
+{
+    if (num_calls == 0) {
+        return PSA_SUCCESS;
+    }
+
+    if (num_calls > BATCH_NUM_MASK) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    return tfm_ns_interface_dispatch(
+                                (veneer_fn)tfm_psa_call_batch_veneer,
+                                (uint32_t)calls,
+                                PARAM_PACK_BATCH(num_calls),
+                                0,
+                                0);
+}
+
 psa_handle_t psa_connect(uint32_t sid, uint32_t version)
 {
     return tfm_ns_interface_dispatch((veneer_fn)tfm_psa_connect_veneer, sid, version, 0, 0);
@@ -185,14 +185,8 @@ static int boot_add_data_to_shared_area(uint8_t        major_type,
 
     boot_data = (struct tfm_boot_data *)BOOT_TFM_SHARED_DATA_BASE;
 
-    /* Check whether the shared area needs to be initialized. */
-    if ((boot_data->header.tlv_magic != SHARED_DATA_TLV_INFO_MAGIC) ||
-        (boot_data->header.tlv_tot_len > BOOT_TFM_SHARED_DATA_SIZE)) {
-
-        memset((void *)BOOT_TFM_SHARED_DATA_BASE, 0, BOOT_TFM_SHARED_DATA_SIZE);
-        boot_data->header.tlv_magic   = SHARED_DATA_TLV_INFO_MAGIC;
-        boot_data->header.tlv_tot_len = SHARED_DATA_HEADER_SIZE;
-    }
+    /* Initialize the shared area if needed. */
+    boot_shared_data_init(boot_data, BOOT_TFM_SHARED_DATA_SIZE);
 
     /* Get the boundaries of TLV section. */
     tlv_end = BOOT_TFM_SHARED_DATA_BASE + boot_data->header.tlv_tot_len;
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "cmsis.h"
+#include "cmsis_compiler.h"
+#include "region_defs.h"
+#include "boot_timeline.h"
+#include "tfm_boot_status.h"
+
+/* Sequence number of the next checkpoint of this stage */
+static uint32_t checkpoint_seq;
+
+__WEAK uint32_t boot_timeline_get_timestamp(void)
+{
+#ifdef DWT_CTRL_CYCCNTENA_Msk
+    /* Enabled by the first stage and never reset, keep it running */
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+void boot_timeline_checkpoint(uint8_t stage, uint16_t checkpoint, uint16_t arg)
+{
+    boot_timeline_checkpoint_at(stage, checkpoint, arg,
+                                boot_timeline_get_timestamp());
+}
+
+void boot_timeline_checkpoint_at(uint8_t stage, uint16_t checkpoint,
+                                 uint16_t arg, uint32_t timestamp)
+{
+    struct boot_timeline_checkpoint value;
+    struct shared_data_tlv_entry tlv_entry;
+    struct tfm_boot_data *boot_data;
+    uintptr_t offset;
+
+    value.timestamp  = timestamp;
+    value.checkpoint = checkpoint;
+    value.arg        = arg;
+
+    boot_data = (struct tfm_boot_data *)BOOT_TFM_SHARED_DATA_BASE;
+
+    /* Initialize the shared area if needed. */
+    boot_shared_data_init(boot_data, BOOT_TFM_SHARED_DATA_SIZE);
+
+    /*
+     * The sequence number makes each entry unique, so the entry is appended
+     * without searching the TLV section for a duplicate.
+     */
+    if (checkpoint_seq > BTL_SEQ_MASK) {
+        return;
+    }
+    if ((boot_data->header.tlv_tot_len + SHARED_DATA_ENTRY_SIZE(sizeof(value)))
+        > BOOT_TFM_SHARED_DATA_SIZE) {
+        return;
+    }
+
+    tlv_entry.tlv_type = SET_TLV_TYPE(TLV_MAJOR_BTL,
+                                      SET_BTL_MINOR(stage, checkpoint_seq));
+    tlv_entry.tlv_len  = sizeof(value);
+    checkpoint_seq++;
+
+    offset = BOOT_TFM_SHARED_DATA_BASE + boot_data->header.tlv_tot_len;
+    memcpy((void *)offset, &tlv_entry, SHARED_DATA_ENTRY_HEADER_SIZE);
+
+    offset += SHARED_DATA_ENTRY_HEADER_SIZE;
+    memcpy((void *)offset, &value, sizeof(value));
+
+    boot_data->header.tlv_tot_len += SHARED_DATA_ENTRY_SIZE(sizeof(value));
+}
@@ -20,6 +20,8 @@
 #include <stdbool.h>
 #include "array.h"
 #include "cmsis.h"
+#include "config_tfm.h"
+#include "critical_section.h"
 #include "region.h"
 #include "mpu_armv8.h"
 #include "common_target_cfg.h"
@@ -71,8 +73,119 @@ REGION_DECLARE(Image$$, TFM_SP_META_PTR_END, $$ZI$$Limit);
 #define ARM_MPU_PRIVILEGE_EXECUTE_NEVER  ( 1U )
 #define ARM_MPU_PRIVILEGE_EXECUTE_OK     ( 0U )
 
+/* Upper bound of the regions implemented by an Armv8-M MPU */
+#define MPU_REGION_NUM_MAX           ( 16U )
+
 #endif /* CONFIG_TFM_ENABLE_MEMORY_PROTECT */
 
+#if CONFIG_TFM_HAL_MEM_CHECK_CACHE_NUM > 0
+/* The access type flags of cmse_check_address_range() */
+#define CMSE_ACCESS_TYPE_MASK           (CMSE_MPU_READ | CMSE_MPU_READWRITE)
+
+/*
+ * A range which passed the memory check. Entries are bound to the boundary and
+ * the CMSE flags they are checked with. An entry is valid only while its
+ * generation equals the current generation, 0 is never valid.
+ */
+struct mem_check_cache_entry_t {
+    uintptr_t base;
+    uintptr_t limit;                    /* Address of the last byte */
+    uintptr_t boundary;
+    int       flags;                    /* CMSE flags without the access type */
+    bool      writable;
+    uint32_t  generation;
+};
+
+static struct mem_check_cache_entry_t
+                        mem_check_cache[CONFIG_TFM_HAL_MEM_CHECK_CACHE_NUM];
+static uint32_t mem_check_cache_generation = 1;
+static uint32_t mem_check_cache_victim = 0;
+
+/*
+ * The cache is shared by all the callers of the memory check, so the entries
+ * and the victim index are only accessed in critical sections.
+ * The current generation is returned to store a range checked after a miss.
+ */
+static bool mem_check_cache_lookup(uintptr_t boundary, uintptr_t base,
+                                   uintptr_t limit, int flags,
+                                   uint32_t *p_generation)
+{
+    struct critical_section_t cs_cache = CRITICAL_SECTION_STATIC_INIT;
+    const struct mem_check_cache_entry_t *p_entry;
+    bool writable = !!(flags & CMSE_MPU_READWRITE);
+    bool hit = false;
+    uint32_t i;
+
+    flags &= ~CMSE_ACCESS_TYPE_MASK;
+
+    CRITICAL_SECTION_ENTER(cs_cache);
+
+    for (i = 0; i < ARRAY_SIZE(mem_check_cache); i++) {
+        p_entry = &mem_check_cache[i];
+        if ((p_entry->generation == mem_check_cache_generation) &&
+            (p_entry->boundary == boundary) && (p_entry->flags == flags) &&
+            (p_entry->base <= base) && (limit <= p_entry->limit) &&
+            (p_entry->writable || !writable)) {
+            hit = true;
+            break;
+        }
+    }
+
+    *p_generation = mem_check_cache_generation;
+
+    CRITICAL_SECTION_LEAVE(cs_cache);
+
+    return hit;
+}
+
+/*
+ * Remember a checked range, replacing the entries in round-robin. The
+ * generation is sampled before the check, so a range checked across an
+ * invalidation is stored already stale.
+ */
+static void mem_check_cache_insert(uint32_t generation, uintptr_t boundary,
+                                   uintptr_t base, uintptr_t limit, int flags)
+{
+    struct critical_section_t cs_cache = CRITICAL_SECTION_STATIC_INIT;
+    struct mem_check_cache_entry_t *p_entry;
+
+    CRITICAL_SECTION_ENTER(cs_cache);
+
+    p_entry = &mem_check_cache[mem_check_cache_victim];
+    mem_check_cache_victim = (mem_check_cache_victim + 1) %
+                             ARRAY_SIZE(mem_check_cache);
+
+    p_entry->base = base;
+    p_entry->limit = limit;
+    p_entry->boundary = boundary;
+    p_entry->flags = flags & ~CMSE_ACCESS_TYPE_MASK;
+    p_entry->writable = !!(flags & CMSE_MPU_READWRITE);
+    p_entry->generation = generation;
+
+    CRITICAL_SECTION_LEAVE(cs_cache);
+}
+
+/* Drop the cached ranges when the secure MPU or SAU settings change */
+static void mem_check_cache_invalidate(void)
+{
+    struct critical_section_t cs_cache = CRITICAL_SECTION_STATIC_INIT;
+    uint32_t i;
+
+    CRITICAL_SECTION_ENTER(cs_cache);
+
+    mem_check_cache_generation++;
+    if (mem_check_cache_generation == 0) {
+        /* Do not let the wrapped generation revive the old entries */
+        for (i = 0; i < ARRAY_SIZE(mem_check_cache); i++) {
+            mem_check_cache[i].generation = 0;
+        }
+        mem_check_cache_generation = 1;
+    }
+
+    CRITICAL_SECTION_LEAVE(cs_cache);
+}
+#endif /* CONFIG_TFM_HAL_MEM_CHECK_CACHE_NUM > 0 */
+
 enum tfm_hal_status_t tfm_hal_set_up_static_boundaries(
                                             uintptr_t *p_spm_boundary)
 {
@@ -188,7 +301,6 @@ const ARM_MPU_Region_t mpu_region_attributes[] = {
     PLATFORM_STATIC_MPU_REGIONS
 #endif
 };
-    ARM_MPU_Region_t localcfg;
 #endif /* CONFIG_TFM_ENABLE_MEMORY_PROTECT */
     /* Set up isolation boundaries between SPE and NSPE */
     sau_and_idau_cfg();
@@ -244,14 +356,10 @@ const ARM_MPU_Region_t mpu_region_attributes[] = {
                        ARM_MPU_ATTR(ARM_MPU_ATTR_DEVICE,
                                     ARM_MPU_ATTR_DEVICE_nGnRE));
 
-    /* Configure regions */
+    /* Configure regions in one burst through the region alias registers */
     /* Note: CMSIS MPU API clears the lower 5 address bits without check */
-    for (i = 0; i < ARRAY_SIZE(mpu_region_attributes); i++) {
-        localcfg.RBAR = mpu_region_attributes[i].RBAR;
-        localcfg.RLAR = mpu_region_attributes[i].RLAR;
-        ARM_MPU_SetRegion(i, localcfg.RBAR, localcfg.RLAR);
-    }
-    n_configured_regions = i;
+    ARM_MPU_Load(0, mpu_region_attributes, ARRAY_SIZE(mpu_region_attributes));
+    n_configured_regions = ARRAY_SIZE(mpu_region_attributes);
 
     /* Enable MPU with the above configurations. Allow default memory map for
      * privileged software and enable MPU during HardFault and NMI handlers.
@@ -259,6 +367,11 @@ const ARM_MPU_Region_t mpu_region_attributes[] = {
     ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_HFNMIENA_Msk);
 #endif /* CONFIG_TFM_ENABLE_MEMORY_PROTECT */
 
+#if CONFIG_TFM_HAL_MEM_CHECK_CACHE_NUM > 0
+    /* SAU and MPU settings are replaced */
+    mem_check_cache_invalidate();
+#endif
+
     *p_spm_boundary = (uintptr_t)PROT_BOUNDARY_VAL;
 
     return TFM_HAL_SUCCESS;
@@ -288,7 +401,8 @@ enum tfm_hal_status_t tfm_hal_bind_boundary(
     size_t mmio_list_length;
 
 #if TFM_ISOLATION_LEVEL == 2
-    ARM_MPU_Region_t local_mpu_region;
+    ARM_MPU_Region_t mmio_regions[MPU_REGION_NUM_MAX];
+    uint32_t n_mmio_regions = 0;
     uint32_t mpu_region_num;
 #endif
     if (!p_ldinf || !p_boundary) {
@@ -343,7 +457,8 @@ enum tfm_hal_status_t tfm_hal_bind_boundary(
         }
 #if TFM_ISOLATION_LEVEL == 2
         /*
-         * Static boundaries are set. Set up MPU region for MMIO.
+         * Static boundaries are set. Collect the MPU regions for MMIO, they
+         * are loaded together once all the assets are validated.
          * Setup regions for unprivileged assets only.
          */
         if (!privileged) {
@@ -351,7 +466,8 @@ enum tfm_hal_status_t tfm_hal_bind_boundary(
                 (MPU->TYPE & MPU_TYPE_DREGION_Msk) >> MPU_TYPE_DREGION_Pos;
 
             /* There is a limited number of available MPU regions in v8M */
-            if (mpu_region_num <= n_configured_regions) {
+            if (mpu_region_num <= n_configured_regions + n_mmio_regions ||
+                n_mmio_regions >= ARRAY_SIZE(mmio_regions)) {
                 return TFM_HAL_ERROR_GENERIC;
             }
             if ((plat_data_ptr->periph_start & ~MPU_RBAR_BASE_Msk) != 0) {
@@ -361,39 +477,47 @@ enum tfm_hal_status_t tfm_hal_bind_boundary(
                 return TFM_HAL_ERROR_GENERIC;
             }
 
-            /* Turn off MPU during configuration */
-            if (MPU->CTRL & MPU_CTRL_ENABLE_Msk) {
-                ARM_MPU_Disable();
-            }
-
             /* Assemble region base and limit address register contents. */
-            local_mpu_region.RBAR = ARM_MPU_RBAR(plat_data_ptr->periph_start,
+            mmio_regions[n_mmio_regions].RBAR =
+                                    ARM_MPU_RBAR(plat_data_ptr->periph_start,
                                                  ARM_MPU_SH_NON,
                                                  ARM_MPU_READ_WRITE,
                                                  ARM_MPU_UNPRIVILEGED,
                                                  ARM_MPU_EXECUTE_NEVER);
             /* Attr2 contains required attribute set for device regions */
             #ifdef TFM_PXN_ENABLE
-            local_mpu_region.RLAR = ARM_MPU_RLAR_PXN(plat_data_ptr->periph_limit,
-                                                     ARM_MPU_PRIVILEGE_EXECUTE_NEVER,
-                                                     2);
+            mmio_regions[n_mmio_regions].RLAR =
+                            ARM_MPU_RLAR_PXN(plat_data_ptr->periph_limit,
+                                             ARM_MPU_PRIVILEGE_EXECUTE_NEVER,
+                                             2);
             #else
-            local_mpu_region.RLAR = ARM_MPU_RLAR(plat_data_ptr->periph_limit,
-                                                 2);
+            mmio_regions[n_mmio_regions].RLAR =
+                                ARM_MPU_RLAR(plat_data_ptr->periph_limit, 2);
             #endif
+            n_mmio_regions++;
+        }
+#endif
+    }
 
-            /* Configure device mpu region */
-            ARM_MPU_SetRegion(n_configured_regions,
-                              local_mpu_region.RBAR,
-                              local_mpu_region.RLAR);
+#if TFM_ISOLATION_LEVEL == 2
+    if (n_mmio_regions > 0) {
+        /* Turn off MPU during configuration */
+        if (MPU->CTRL & MPU_CTRL_ENABLE_Msk) {
+            ARM_MPU_Disable();
+        }
 
-            n_configured_regions++;
+        /* Configure the device mpu regions of the partition in one burst */
+        ARM_MPU_Load(n_configured_regions, mmio_regions, n_mmio_regions);
+        n_configured_regions += n_mmio_regions;
 
-            /* Enable MPU with the new region added */
-            ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_HFNMIENA_Msk);
-        }
+#if CONFIG_TFM_HAL_MEM_CHECK_CACHE_NUM > 0
+        mem_check_cache_invalidate();
 #endif
+
+        /* Enable MPU with the new regions added */
+        ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_HFNMIENA_Msk);
     }
+#endif
 
     partition_attrs = ((uint32_t)privileged << HANDLE_ATTR_PRIV_POS) &
                         HANDLE_ATTR_PRIV_MASK;
@@ -411,10 +535,16 @@ enum tfm_hal_status_t tfm_hal_activate_boundary(
     CONTROL_Type ctrl;
     bool privileged = !!((uint32_t)boundary & HANDLE_ATTR_PRIV_MASK);
 
-    /* Privileged level is required to be set always */
+    /*
+     * The MPU regions are static after binding, so only the privilege level
+     * follows the boundary. Skip the CONTROL update and the barrier it
+     * implies when the level does not change.
+     */
     ctrl.w = __get_CONTROL();
-    ctrl.b.nPRIV = privileged ? 0 : 1;
-    __set_CONTROL(ctrl.w);
+    if (ctrl.b.nPRIV != (privileged ? 0U : 1U)) {
+        ctrl.b.nPRIV = privileged ? 0 : 1;
+        __set_CONTROL(ctrl.w);
+    }
 
     return TFM_HAL_SUCCESS;
 }
@@ -423,6 +553,11 @@ enum tfm_hal_status_t tfm_hal_memory_check(uintptr_t boundary, uintptr_t base,
                                            size_t size, uint32_t access_type)
 {
     int flags = 0;
+#if CONFIG_TFM_HAL_MEM_CHECK_CACHE_NUM > 0
+    uintptr_t limit = base + size - 1;
+    uint32_t generation = 0;
+    bool cacheable;
+#endif
 
     /* If size is zero, this indicates an empty buffer and base is ignored */
     if (size == 0) {
@@ -461,7 +596,25 @@ enum tfm_hal_status_t tfm_hal_memory_check(uintptr_t boundary, uintptr_t base,
         flags |= CMSE_NONSECURE;
     }
 
+#if CONFIG_TFM_HAL_MEM_CHECK_CACHE_NUM > 0
+    /*
+     * NS ranges depend on the NS MPU, which the NS OS may reprogram at any
+     * time, so they are always checked. Ranges wrapping around the address
+     * space are left to the check too.
+     */
+    cacheable = !(flags & CMSE_NONSECURE) && (limit >= base);
+    if (cacheable &&
+        mem_check_cache_lookup(boundary, base, limit, flags, &generation)) {
+        return TFM_HAL_SUCCESS;
+    }
+#endif
+
     if (cmse_check_address_range((void *)base, size, flags) != NULL) {
+#if CONFIG_TFM_HAL_MEM_CHECK_CACHE_NUM > 0
+        if (cacheable) {
+            mem_check_cache_insert(generation, boundary, base, limit, flags);
+        }
+#endif
         return TFM_HAL_SUCCESS;
     } else {
         return TFM_HAL_ERROR_MEM_FAULT;
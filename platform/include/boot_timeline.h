@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __BOOT_TIMELINE_H__
+#define __BOOT_TIMELINE_H__
+
+#include <stdint.h>
+#ifdef CONFIG_TFM_BOOT_TIMELINE
+#include "tfm_boot_status.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Get the timestamp of the boot timeline checkpoints.
+ *
+ * \note  The counter must keep running across the boot stages, so every
+ *        stage reads the same time base. The default implementation uses the
+ *        DWT cycle counter and returns 0 on cores without it. It can be
+ *        overridden with a platform timer.
+ *
+ * \return Returns the current timestamp.
+ */
+uint32_t boot_timeline_get_timestamp(void);
+
+/**
+ * \brief Record a timestamped checkpoint of the boot timeline into the shared
+ *        data area, as a TLV_MAJOR_BTL entry.
+ *
+ * \note  Checkpoints are best effort: they are dropped silently when the
+ *        shared data area is full, as they must not break the boot.
+ *
+ * \param[in] stage       The boot stage, BTL_STAGE_*.
+ * \param[in] checkpoint  The checkpoint, BTL_CP_*.
+ * \param[in] arg         Image ID or partition ID, 0 if not applicable.
+ */
+void boot_timeline_checkpoint(uint8_t stage, uint16_t checkpoint, uint16_t arg);
+
+/**
+ * \brief Record a checkpoint of the boot timeline with a timestamp taken
+ *        earlier, when the shared data area could not be written yet.
+ *
+ * \param[in] stage       The boot stage, BTL_STAGE_*.
+ * \param[in] checkpoint  The checkpoint, BTL_CP_*.
+ * \param[in] arg         Image ID or partition ID, 0 if not applicable.
+ * \param[in] timestamp   The timestamp of the checkpoint.
+ */
+void boot_timeline_checkpoint_at(uint8_t stage, uint16_t checkpoint,
+                                 uint16_t arg, uint32_t timestamp);
+
+#ifdef CONFIG_TFM_BOOT_TIMELINE
+#define BOOT_TIMELINE_CHECKPOINT(stage, checkpoint, arg) \
+                    boot_timeline_checkpoint((stage), (checkpoint), (arg))
+/* Declare and take a timestamp for BOOT_TIMELINE_CHECKPOINT_AT() */
+#define BOOT_TIMELINE_TIMESTAMP(ts) \
+                    uint32_t ts = boot_timeline_get_timestamp()
+#define BOOT_TIMELINE_CHECKPOINT_AT(stage, checkpoint, arg, ts) \
+                    boot_timeline_checkpoint_at((stage), (checkpoint), (arg), (ts))
+#else
+#define BOOT_TIMELINE_CHECKPOINT(stage, checkpoint, arg)
+#define BOOT_TIMELINE_TIMESTAMP(ts)
+#define BOOT_TIMELINE_CHECKPOINT_AT(stage, checkpoint, arg, ts)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOT_TIMELINE_H__ */
@@ -13,6 +13,11 @@
 
 #include "tfm_multi_core.h"
 
+/* The maximum number of platform specific memory regions */
+#ifndef TFM_HAL_EXTRA_MEM_REGION_MAX
+#define TFM_HAL_EXTRA_MEM_REGION_MAX    8
+#endif
+
 /**
  * \brief Performs the necessary actions to start the non-secure CPU running
  *        the code at the specified address.
@@ -68,4 +73,22 @@ void tfm_hal_get_secure_access_attr(const void *p, size_t s,
 void tfm_hal_get_ns_access_attr(const void *p, size_t s,
                                 struct mem_attr_info_t *p_attr);
 
+/**
+ * \brief Retrieve the platform specific memory regions checked besides the
+ *        secure and non-secure code and data regions of the memory layout,
+ *        such as the memory windows shared between the cores.
+ *
+ * \note  The regions are collected once, at the first memory access check.
+ *        They must not overlap each other, but can be inside a region of the
+ *        memory layout. A range inside such a region takes its attributes.
+ *        The default implementation returns no region.
+ *
+ * \param[out] nr_regions     The number of regions, up to
+ *                            \ref TFM_HAL_EXTRA_MEM_REGION_MAX
+ *
+ * \return Returns the array of regions, or NULL if there is none.
+ */
+const struct mem_region_attr_t *
+tfm_hal_get_extra_mem_regions(uint32_t *nr_regions);
+
 #endif /* __TFM_HAL_MULTI_CORE_H__ */
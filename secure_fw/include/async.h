@@ -16,4 +16,10 @@
  */
 #define ASYNC_MSG_REPLY    (0x00000004u)
 
+/**
+ * The signal number for the replies to the psa_call_async() requests of a
+ * Secure Partition.
+ */
+#define ASYNC_CALL_REPLY   (0x00000002u)
+
 #endif /* __ASYNC_H__ */
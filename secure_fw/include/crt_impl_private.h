@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2020-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -13,6 +13,22 @@
 
 #define ADDR_WORD_UNALIGNED(x)        ((x) & 0x3)
 
+/* Words moved in one burst, which the compiler folds into LDM/STM. */
+#define CRT_BURST_WORDS               4
+#define CRT_BURST_SIZE                (CRT_BURST_WORDS * sizeof(uint32_t))
+
+/*
+ * Merge two adjacent aligned words into the word starting 'shift' bits into
+ * the word at the lower address. 'shift' is 8, 16 or 24.
+ */
+#ifdef __ARM_BIG_ENDIAN
+#define CRT_MERGE_WORDS(lo, hi, shift) \
+                        (((lo) << (shift)) | ((hi) >> (32U - (shift))))
+#else
+#define CRT_MERGE_WORDS(lo, hi, shift) \
+                        (((lo) >> (shift)) | ((hi) << (32U - (shift))))
+#endif
+
 union composite_addr_t {
     uintptr_t uint_addr;        /* Address as integer value  */
     uint8_t   *p_byte;          /* Address in BYTE pointer   */
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "config_tfm.h"
+#include "service_api.h"
+#include "tfm_diag_defs.h"
+#include "psa/client.h"
+#include "psa/service.h"
+#include "psa_manifest/tfm_diagnostics.h"
+
+static psa_status_t diagnostics_get_service_stats(const psa_msg_t *msg)
+{
+    struct tfm_diag_service_stats_t stats;
+    uint32_t index;
+    size_t offset;
+
+    if (msg->in_size[0] != sizeof(index) ||
+        msg->out_size[0] < sizeof(stats)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (psa_read(msg->handle, 0, &index, sizeof(index)) != sizeof(index)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /* Fill as many entries as the client buffer holds */
+    for (offset = 0; offset + sizeof(stats) <= msg->out_size[0];
+         offset += sizeof(stats)) {
+        if (tfm_core_get_service_stats(index++, &stats) != PSA_SUCCESS) {
+            break;
+        }
+        psa_write(msg->handle, 0, &stats, sizeof(stats));
+    }
+
+    return PSA_SUCCESS;
+}
+
+/* Only secure clients can clear the statistics seen by all the clients */
+static psa_status_t diagnostics_reset_service_stats(const psa_msg_t *msg)
+{
+    if (msg->client_id <= 0) {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+
+    return tfm_core_reset_service_stats();
+}
+
+static psa_status_t diagnostics_get_conn_pool_stats(const psa_msg_t *msg)
+{
+    struct tfm_diag_conn_pool_stats_t stats;
+    psa_status_t status;
+
+    if (msg->out_size[0] < sizeof(stats)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = tfm_core_get_conn_pool_stats(&stats);
+    if (status == PSA_SUCCESS) {
+        psa_write(msg->handle, 0, &stats, sizeof(stats));
+    }
+
+    return status;
+}
+
+psa_status_t tfm_diagnostics_service_sfn(const psa_msg_t *msg)
+{
+    switch (msg->type) {
+    case TFM_DIAG_API_ID_GET_SERVICE_STATS:
+        return diagnostics_get_service_stats(msg);
+    case TFM_DIAG_API_ID_RESET_SERVICE_STATS:
+        return diagnostics_reset_service_stats(msg);
+    case TFM_DIAG_API_ID_GET_CONN_POOL_STATS:
+        return diagnostics_get_conn_pool_stats(msg);
+    default:
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+}
+
+psa_status_t diagnostics_sp_init(void)
+{
+    return PSA_SUCCESS;
+}
@@ -21,23 +21,6 @@
     #error "FWU_COMPONENT_NUMBER mismatch with MCUBOOT_IMAGE_NUMBER"
 #endif
 
-#define MAX_IMAGE_INFO_LENGTH   (MCUBOOT_IMAGE_NUMBER * \
-                                (sizeof(struct image_version) + \
-                                 SHARED_DATA_ENTRY_HEADER_SIZE))
-
-/*
- * \struct fwu_image_info_data
- *
- * \brief Contains the received boot status information from bootloader
- *
- * \details This is a redefinition of \ref tfm_boot_data to allocate the
- *          appropriate, service dependent size of \ref boot_data.
- */
-typedef struct fwu_image_info_data_s {
-    struct shared_data_tlv_header header;
-    uint8_t data[MAX_IMAGE_INFO_LENGTH];
-} fwu_image_info_data_t;
-
 typedef struct tfm_fwu_mcuboot_ctx_s {
     /* The flash area corresponding to component. */
     const struct flash_area *fap;
@@ -47,56 +30,32 @@ typedef struct tfm_fwu_mcuboot_ctx_s {
 } tfm_fwu_mcuboot_ctx_t;
 
 static tfm_fwu_mcuboot_ctx_t mcuboot_ctx[FWU_COMPONENT_NUMBER];
-static fwu_image_info_data_t __attribute__((aligned(4))) boot_shared_data;
-
-static psa_status_t fwu_bootloader_get_shared_data(void)
-{
-    return tfm_core_get_boot_data(TLV_MAJOR_FWU,
-                                  (struct tfm_boot_data *)&boot_shared_data,
-                                  sizeof(boot_shared_data));
-}
 
 static psa_status_t get_active_image_version(psa_fwu_component_t component,
                                              struct image_version *image_ver)
 {
-    struct shared_data_tlv_entry tlv_entry;
-    uint8_t *tlv_end;
-    uint8_t *tlv_curr;
+    uint32_t len;
 
     /* The bootloader writes the image version information into the memory which
-     * is shared between MCUboot and TF-M. Read the shared memory.
+     * is shared between MCUboot and TF-M. Fetch the TLV of the component.
      */
-    if (boot_shared_data.header.tlv_magic != SHARED_DATA_TLV_INFO_MAGIC) {
+    if (tfm_core_get_boot_data_tlv(SET_TLV_TYPE(TLV_MAJOR_FWU,
+                                                SET_FWU_MINOR(component,
+                                                              SW_VERSION)),
+                                   image_ver, sizeof(*image_ver),
+                                   &len) != PSA_SUCCESS) {
         return PSA_ERROR_DATA_CORRUPT;
     }
 
-    tlv_end = (uint8_t *)&boot_shared_data +
-                boot_shared_data.header.tlv_tot_len;
-    tlv_curr = boot_shared_data.data;
-
-    while (tlv_curr < tlv_end) {
-        (void)memcpy(&tlv_entry, tlv_curr, SHARED_DATA_ENTRY_HEADER_SIZE);
-        if ((GET_FWU_CLAIM(tlv_entry.tlv_type) == SW_VERSION) &&
-            (GET_FWU_MODULE(tlv_entry.tlv_type) == component)) {
-            if (tlv_entry.tlv_len != sizeof(struct image_version)) {
-                return PSA_ERROR_DATA_CORRUPT;
-            }
-            memcpy(image_ver,
-                tlv_curr + SHARED_DATA_ENTRY_HEADER_SIZE,
-                tlv_entry.tlv_len);
-            return PSA_SUCCESS;
-        }
-        tlv_curr += SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len;
+    if (len != sizeof(struct image_version)) {
+        return PSA_ERROR_DATA_CORRUPT;
     }
 
-    return PSA_ERROR_DATA_CORRUPT;
+    return PSA_SUCCESS;
 }
 
 psa_status_t fwu_bootloader_init(void)
 {
-    if (fwu_bootloader_get_shared_data() != PSA_SUCCESS) {
-        return PSA_ERROR_STORAGE_FAILURE;
-    }
     /* add Init of specific flash driver */
     flash_area_driver_init();
     return PSA_SUCCESS;
@@ -31,6 +31,7 @@ struct partition_tfm_sp_idle_load_info_t {
     /* per-partition variable length load data */
     uintptr_t                       stack_addr;
     uintptr_t                       heap_addr;
+    uintptr_t                       deps_bitmap;
 #if TFM_ISOLATION_LEVEL == 3
     struct asset_desc_t             assets[TFM_SP_IDLE_NASSETS];
 #endif
@@ -67,6 +68,7 @@ const struct partition_tfm_sp_idle_load_info_t
     },
     .stack_addr                     = (uintptr_t)idle_sp_stack,
     .heap_addr                      = 0,
+    .deps_bitmap                    = 0,
 #if TFM_ISOLATION_LEVEL == 3
     .assets                         = {
         {
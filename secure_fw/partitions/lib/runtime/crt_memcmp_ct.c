@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+int tfm_memcmp_ct(const void *s1, const void *s2, size_t n)
+{
+    /* Volatile accesses keep the compiler from stopping at a difference. */
+    const volatile uint8_t *p1 = (const volatile uint8_t *)s1;
+    const volatile uint8_t *p2 = (const volatile uint8_t *)s2;
+    uint8_t diff = 0;
+    size_t idx;
+
+    for (idx = 0; idx < n; idx++) {
+        diff |= p1[idx] ^ p2[idx];
+    }
+
+    return (int)diff;
+}
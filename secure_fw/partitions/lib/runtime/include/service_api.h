@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 #include "tfm_boot_status.h"
+#include "tfm_diag_defs.h"
 #include "psa/error.h"
 
 /**
@@ -23,4 +24,59 @@ psa_status_t tfm_core_get_boot_data(uint8_t major_type,
                                     struct tfm_boot_data *boot_data,
                                     uint32_t len);
 
+/**
+ * \brief Retrieve the value of a single TLV from the shared memory area, which
+ *        stores shared data between bootloader and runtime firmware. The TLV
+ *        is looked up through an index, without copying the other TLVs.
+ *
+ * \param[in]  tlv_type  Full TLV type, major and minor.
+ * \param[out] buf       Buffer to hold the value of the TLV.
+ * \param[in]  size      The size of the buffer.
+ * \param[out] len       The length of the value. Also set when the buffer is
+ *                       too small, to size it.
+ *
+ * \retval PSA_SUCCESS                  The value is copied to the buffer.
+ * \retval PSA_ERROR_DOES_NOT_EXIST     No TLV with this type.
+ * \retval PSA_ERROR_BUFFER_TOO_SMALL   The buffer is too small for the value.
+ * \retval PSA_ERROR_INVALID_ARGUMENT   Invalid buffer, or no access right to
+ *                                      the major type.
+ */
+psa_status_t tfm_core_get_boot_data_tlv(uint16_t tlv_type, void *buf,
+                                        uint32_t size, uint32_t *len);
+
+#ifdef CONFIG_TFM_SPM_SERVICE_STATS
+/**
+ * \brief Get a snapshot of the statistics the SPM keeps for one RoT Service.
+ *
+ * \param[in]  index  Index of the service, services are enumerated in the
+ *                    partition load order.
+ * \param[out] stats  Buffer to hold the statistics.
+ *
+ * \retval PSA_SUCCESS                  The statistics are copied.
+ * \retval PSA_ERROR_DOES_NOT_EXIST     \a index is beyond the last service.
+ * \retval PSA_ERROR_INVALID_ARGUMENT   Invalid buffer.
+ */
+psa_status_t tfm_core_get_service_stats(uint32_t index,
+                                        struct tfm_diag_service_stats_t *stats);
+
+/**
+ * \brief Clear the statistics the SPM keeps for all RoT Services.
+ *
+ * \retval PSA_SUCCESS                  The statistics are cleared.
+ */
+psa_status_t tfm_core_reset_service_stats(void);
+
+/**
+ * \brief Get a snapshot of the usage of the SPM connection pool.
+ *
+ * \param[out] stats  Buffer to hold the statistics.
+ *
+ * \retval PSA_SUCCESS                  The statistics are copied.
+ * \retval PSA_ERROR_NOT_SUPPORTED      The SPM has no connection pool.
+ * \retval PSA_ERROR_INVALID_ARGUMENT   Invalid buffer.
+ */
+psa_status_t tfm_core_get_conn_pool_stats(
+                                    struct tfm_diag_conn_pool_stats_t *stats);
+#endif /* CONFIG_TFM_SPM_SERVICE_STATS */
+
 #endif /* __SERVICE_API_H__ */
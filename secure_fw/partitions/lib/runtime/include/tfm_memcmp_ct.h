@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#ifndef __TFM_MEMCMP_CT_H__
+#define __TFM_MEMCMP_CT_H__
+
+#include <stddef.h>
+
+/**
+ * \brief Compare two buffers in a time independent of their contents, to be
+ *        used on secrets such as MACs and keys.
+ *
+ * \param[in]  s1          Points to the first buffer.
+ * \param[in]  s2          Points to the second buffer.
+ * \param[in]  n           The number of bytes to compare.
+ *
+ * \return 0 if the buffers are equal, non-zero otherwise.
+ */
+int tfm_memcmp_ct(const void *s1, const void *s2, size_t n);
+
+#endif /* __TFM_MEMCMP_CT_H__ */
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_PSA_CALL_ASYNC_H__
+#define __TFM_PSA_CALL_ASYNC_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "async.h"
+#include "psa/client.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Call an RoT Service without waiting for the reply.
+ *
+ * \details The reply is signalled to the caller with \ref ASYNC_CALL_REPLY
+ *          and collected with \ref psa_get_reply. The vectors and the memory
+ *          they describe must stay valid and untouched until then. Available
+ *          to Secure Partitions of the IPC model only.
+ *
+ * \param[in] handle            A handle to an established connection, or a
+ *                              stateless handle.
+ * \param[in] type              Request type, as for \ref psa_call.
+ * \param[in] in_vec            Array of input psa_invec structures.
+ * \param[in] in_len            Number of input psa_invec structures.
+ * \param[in,out] out_vec       Array of output psa_outvec structures.
+ * \param[in] out_len           Number of output psa_outvec structures.
+ *
+ * \retval >0                   Handle identifying the request in the reply.
+ * \retval PSA_ERROR_CONNECTION_BUSY The SPM has no free connection for a
+ *                              stateless handle.
+ * \retval "PROGRAMMER ERROR"   The call is invalid as for \ref psa_call. A
+ *                              connection still handling a request is
+ *                              invalid too.
+ */
+psa_handle_t psa_call_async(psa_handle_t handle, int32_t type,
+                            const psa_invec *in_vec, size_t in_len,
+                            psa_outvec *out_vec, size_t out_len);
+
+/**
+ * \brief Collect the oldest pending reply of \ref psa_call_async.
+ *
+ * \details Call it after \ref psa_wait returned \ref ASYNC_CALL_REPLY. The
+ *          signal is cleared once no reply is left.
+ *
+ * \param[out] p_request        The handle returned by the matching
+ *                              \ref psa_call_async.
+ *
+ * \retval >=0                  The status replied by the RoT Service.
+ * \retval <0                   The error status replied by the RoT Service.
+ * \retval "PROGRAMMER ERROR"   No reply is pending or \a p_request is
+ *                              invalid.
+ */
+psa_status_t psa_get_reply(psa_handle_t *p_request);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_PSA_CALL_ASYNC_H__ */
@@ -7,7 +7,9 @@
 
 #include <stdint.h>
 #include "psa/client.h"
+#include "psa/service.h"
 #include "config_impl.h"
+#include "tfm_psa_call_async.h"
 #include "tfm_psa_call_pack.h"
 #include "sprt_partition_metadata_indicator.h"
 #include "runtime_defs.h"
@@ -31,6 +33,12 @@ psa_status_t tfm_psa_call_pack(psa_handle_t handle,
                                               in_vec, out_vec);
 }
 
+psa_status_t tfm_psa_call_batch_pack(psa_call_desc_t *calls,
+                                     uint32_t ctrl_param)
+{
+    return PART_METADATA()->psa_fns->psa_call_batch(calls, ctrl_param);
+}
+
 psa_signal_t psa_wait(psa_signal_t signal_mask, uint32_t timeout)
 {
     return PART_METADATA()->psa_fns->psa_wait(signal_mask, timeout);
@@ -102,6 +110,29 @@ void psa_clear(void)
 }
 #endif /* CONFIG_TFM_DOORBELL_API == 1 */
 
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+psa_handle_t psa_call_async(psa_handle_t handle, int32_t type,
+                            const psa_invec *in_vec, size_t in_len,
+                            psa_outvec *out_vec, size_t out_len)
+{
+    if ((type    > PSA_CALL_TYPE_MAX) ||
+        (type    < PSA_CALL_TYPE_MIN) ||
+        (in_len  > PSA_MAX_IOVEC)     ||
+        (out_len > PSA_MAX_IOVEC)) {
+        psa_panic();
+    }
+
+    return PART_METADATA()->psa_fns->psa_call_async(handle,
+                                        PARAM_PACK(type, in_len, out_len),
+                                        in_vec, out_vec);
+}
+
+psa_status_t psa_get_reply(psa_handle_t *p_request)
+{
+    return PART_METADATA()->psa_fns->psa_get_reply(p_request);
+}
+#endif /* CONFIG_TFM_ASYNC_CALL_API == 1 */
+
 #if CONFIG_TFM_FLIH_API == 1 || CONFIG_TFM_SLIH_API == 1
 void psa_irq_enable(psa_signal_t irq_signal)
 {
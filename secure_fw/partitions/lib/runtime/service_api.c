@@ -22,6 +22,47 @@ psa_status_t tfm_core_get_boot_data(uint8_t major_type,
         );
 }
 
+__attribute__((naked))
+psa_status_t tfm_core_get_boot_data_tlv(uint16_t tlv_type, void *buf,
+                                        uint32_t size, uint32_t *len)
+{
+    __ASM volatile(
+        "SVC    "M2S(TFM_SVC_GET_BOOT_DATA_TLV)"           \n"
+        "BX     lr                                         \n"
+        );
+}
+
+#ifdef CONFIG_TFM_SPM_SERVICE_STATS
+__attribute__((naked))
+psa_status_t tfm_core_get_service_stats(uint32_t index,
+                                        struct tfm_diag_service_stats_t *stats)
+{
+    __ASM volatile(
+        "SVC    "M2S(TFM_SVC_GET_SERVICE_STATS)"           \n"
+        "BX     lr                                         \n"
+        );
+}
+
+__attribute__((naked))
+psa_status_t tfm_core_reset_service_stats(void)
+{
+    __ASM volatile(
+        "SVC    "M2S(TFM_SVC_RESET_SERVICE_STATS)"         \n"
+        "BX     lr                                         \n"
+        );
+}
+
+__attribute__((naked))
+psa_status_t tfm_core_get_conn_pool_stats(
+                                    struct tfm_diag_conn_pool_stats_t *stats)
+{
+    __ASM volatile(
+        "SVC    "M2S(TFM_SVC_GET_CONN_POOL_STATS)"         \n"
+        "BX     lr                                         \n"
+        );
+}
+#endif /* CONFIG_TFM_SPM_SERVICE_STATS */
+
 #if TFM_ISOLATION_LEVEL != 1
 /* Entry point when Partition FLIH functions return */
 __attribute__((naked))
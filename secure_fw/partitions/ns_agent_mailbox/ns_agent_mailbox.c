@@ -29,6 +29,12 @@ void ns_agent_mailbox_entry(void)
 {
     psa_signal_t signals = 0;
 
+    /* Do not boot NSPE on an invalid memory layout */
+    if (tfm_mem_region_init()) {
+        LOG_ERRFMT("Invalid memory layout for access checks\r\n");
+        psa_panic();
+    }
+
     boot_ns_core();
 
     if (tfm_inter_core_comm_init()) {
@@ -11,10 +11,13 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "cmsis_compiler.h"
+#include "critical_section.h"
 #include "internal_status_code.h"
 #include "region.h"
 #include "region_defs.h"
 #include "tfm_hal_multi_core.h"
+#include "tfm_mailbox_config.h"
 #include "tfm_multi_core.h"
 #include "tfm_arch.h"
 #include "utilities.h"
@@ -23,34 +26,126 @@
 #error TFM_ISOLATION_LEVEL is not defined!
 #endif
 
-void tfm_get_mem_region_security_attr(const void *p, size_t s,
-                                      struct security_attr_info_t *p_attr)
+/* Access permissions of the memory regions */
+#define REGION_PRIV_RD          (1U << 0)
+#define REGION_PRIV_WR          (1U << 1)
+#define REGION_UNPRIV_RD        (1U << 2)
+#define REGION_UNPRIV_WR        (1U << 3)
+#define REGION_XN               (1U << 4)
+
+#define REGION_CODE             (REGION_PRIV_RD | REGION_UNPRIV_RD)
+#define REGION_DATA             (REGION_PRIV_RD | REGION_PRIV_WR | \
+                                 REGION_UNPRIV_RD | REGION_UNPRIV_WR | \
+                                 REGION_XN)
+#define REGION_RO_DATA          (REGION_PRIV_RD | REGION_UNPRIV_RD | REGION_XN)
+#define REGION_PRIV_CODE        (REGION_PRIV_RD)
+#define REGION_PRIV_DATA        (REGION_PRIV_RD | REGION_PRIV_WR | REGION_XN)
+
+/* Secure and non-secure code and data regions of the memory layout */
+#define NR_LAYOUT_REGIONS       4
+
+#if TFM_ISOLATION_LEVEL == 2
+/* Partition regions with their own attributes inside the secure regions */
+#define NR_ISOLATION_REGIONS    4
+#else
+#define NR_ISOLATION_REGIONS    0
+#endif
+
+#define NR_SUB_REGIONS_MAX      (NR_ISOLATION_REGIONS + \
+                                 TFM_HAL_EXTRA_MEM_REGION_MAX)
+
+/*
+ * Both tables are sorted by base address, without overlapping regions, and
+ * collected once at initialization. A range inside a sub-region takes the
+ * attributes of the sub-region. A range outside of all the sub-regions takes
+ * the ones of the layout region. A range partly inside a sub-region is
+ * rejected.
+ */
+static struct mem_region_attr_t layout_regions[NR_LAYOUT_REGIONS];
+static uint32_t nr_layout_regions;
+static struct mem_region_attr_t sub_regions[NR_SUB_REGIONS_MAX];
+static uint32_t nr_sub_regions;
+static bool is_mem_region_init = false;
+/* False if the tables cannot be built. All the checks fail then. */
+static bool is_mem_region_valid = false;
+
+#if NUM_MAILBOX_SHM_BUF > 0
+/* Non-secure regions shared with NSPE, validated once at initialization */
+static struct mem_region_attr_t ns_shared_regions[NUM_MAILBOX_SHM_BUF];
+static uint32_t nr_ns_shared_regions;
+#endif
+
+__WEAK const struct mem_region_attr_t *
+tfm_hal_get_extra_mem_regions(uint32_t *nr_regions)
 {
-    p_attr->is_valid = true;
+    *nr_regions = 0;
 
-    if (check_address_range(p, s, NS_DATA_START,
-                            NS_DATA_LIMIT) == SPM_SUCCESS) {
-        p_attr->is_secure = false;
-        return;
+    return NULL;
+}
+
+/*
+ * Insert a region in order of base address.
+ * Returns SPM_ERROR_GENERIC if the table is full or the region overlaps
+ * another one.
+ */
+static int32_t insert_mem_region(struct mem_region_attr_t *regions,
+                                 uint32_t *nr_regions, uint32_t max_regions,
+                                 const struct mem_region_attr_t *region)
+{
+    uint32_t i, pos;
+
+    if (*nr_regions >= max_regions) {
+        return SPM_ERROR_GENERIC;
     }
 
-    if (check_address_range(p, s, NS_CODE_START,
-                            NS_CODE_LIMIT) == SPM_SUCCESS) {
-        p_attr->is_secure = false;
-        return;
+    for (pos = *nr_regions; pos > 0; pos--) {
+        if (regions[pos - 1].base < region->base) {
+            break;
+        }
     }
 
-    if (check_address_range(p, s, S_DATA_START, S_DATA_LIMIT) == SPM_SUCCESS) {
-        p_attr->is_secure = true;
-        return;
+    if ((pos > 0) && (regions[pos - 1].limit >= region->base)) {
+        return SPM_ERROR_GENERIC;
     }
 
-    if (check_address_range(p, s, S_CODE_START, S_CODE_LIMIT) == SPM_SUCCESS) {
-        p_attr->is_secure = true;
-        return;
+    if ((pos < *nr_regions) && (regions[pos].base <= region->limit)) {
+        return SPM_ERROR_GENERIC;
     }
 
-    p_attr->is_valid = false;
+    for (i = *nr_regions; i > pos; i--) {
+        regions[i] = regions[i - 1];
+    }
+
+    regions[pos] = *region;
+    regions[pos].attr.is_mpu_enabled = false;
+    regions[pos].attr.is_valid = true;
+    (*nr_regions)++;
+
+    return SPM_SUCCESS;
+}
+
+static int32_t add_mem_region(struct mem_region_attr_t *regions,
+                              uint32_t *nr_regions, uint32_t max_regions,
+                              uintptr_t base, uintptr_t limit, bool is_secure,
+                              uint32_t perm)
+{
+    struct mem_region_attr_t region;
+
+    /* Empty region */
+    if (limit < base) {
+        return SPM_SUCCESS;
+    }
+
+    region.base = base;
+    region.limit = limit;
+    region.is_secure = is_secure;
+    region.attr.is_xn = !!(perm & REGION_XN);
+    region.attr.is_priv_rd_allow = !!(perm & REGION_PRIV_RD);
+    region.attr.is_priv_wr_allow = !!(perm & REGION_PRIV_WR);
+    region.attr.is_unpriv_rd_allow = !!(perm & REGION_UNPRIV_RD);
+    region.attr.is_unpriv_wr_allow = !!(perm & REGION_UNPRIV_WR);
+
+    return insert_mem_region(regions, nr_regions, max_regions, &region);
 }
 
 #if TFM_ISOLATION_LEVEL == 2
@@ -64,149 +159,258 @@ REGION_DECLARE(Image$$, TFM_APP_CODE_START, $$Base);
 REGION_DECLARE(Image$$, TFM_APP_CODE_END, $$Base);
 REGION_DECLARE(Image$$, TFM_APP_RW_STACK_START, $$Base);
 REGION_DECLARE(Image$$, TFM_APP_RW_STACK_END, $$Base);
-#endif
 
-void tfm_get_secure_mem_region_attr(const void *p, size_t s,
-                                    struct mem_attr_info_t *p_attr)
+static int32_t add_isolation_regions(void)
 {
-#if TFM_ISOLATION_LEVEL == 1
-    p_attr->is_mpu_enabled = false;
-    p_attr->is_valid = true;
-
-    if (check_address_range(p, s, S_DATA_START, S_DATA_LIMIT) == SPM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = true;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = true;
-        p_attr->is_xn = true;
-        return;
-    }
-
-    if (check_address_range(p, s, S_CODE_START, S_CODE_LIMIT) == SPM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = false;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = false;
-        return;
-    }
-
-    p_attr->is_valid = false;
-#elif TFM_ISOLATION_LEVEL == 2
     uintptr_t base, limit;
 
-    p_attr->is_mpu_enabled = false;
-    p_attr->is_valid = true;
-
     /* TFM Core unprivileged code region */
     base = (uintptr_t)&REGION_NAME(Image$$, TFM_UNPRIV_CODE_START, $$RO$$Base);
     limit = (uintptr_t)&REGION_NAME(Image$$, TFM_UNPRIV_CODE_END, $$RO$$Limit) - 1;
-    if (check_address_range(p, s, base, limit) == SPM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = false;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = false;
-        return;
+    if (add_mem_region(sub_regions, &nr_sub_regions, NR_SUB_REGIONS_MAX,
+                       base, limit, true, REGION_CODE) != SPM_SUCCESS) {
+        return SPM_ERROR_GENERIC;
     }
 
 #ifdef CONFIG_TFM_PARTITION_META
     /* TFM partition metadata pointer region */
     base = (uintptr_t)&REGION_NAME(Image$$, TFM_SP_META_PTR, $$ZI$$Base);
     limit = (uintptr_t)&REGION_NAME(Image$$, TFM_SP_META_PTR, $$ZI$$Limit) - 1;
-    if (check_address_range(p, s, base, limit) == SPM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = true;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = true;
-        p_attr->is_xn = true;
-        return;
+    if (add_mem_region(sub_regions, &nr_sub_regions, NR_SUB_REGIONS_MAX,
+                       base, limit, true, REGION_DATA) != SPM_SUCCESS) {
+        return SPM_ERROR_GENERIC;
     }
 #endif
 
     /* APP RoT partition RO region */
     base = (uintptr_t)&REGION_NAME(Image$$, TFM_APP_CODE_START, $$Base);
     limit = (uintptr_t)&REGION_NAME(Image$$, TFM_APP_CODE_END, $$Base) - 1;
-    if (check_address_range(p, s, base, limit) == SPM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = false;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = false;
-        return;
+    if (add_mem_region(sub_regions, &nr_sub_regions, NR_SUB_REGIONS_MAX,
+                       base, limit, true, REGION_CODE) != SPM_SUCCESS) {
+        return SPM_ERROR_GENERIC;
     }
 
     /* RW, ZI and stack as one region */
     base = (uintptr_t)&REGION_NAME(Image$$, TFM_APP_RW_STACK_START, $$Base);
     limit = (uintptr_t)&REGION_NAME(Image$$, TFM_APP_RW_STACK_END, $$Base) - 1;
-    if (check_address_range(p, s, base, limit) == SPM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = true;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = true;
-        p_attr->is_xn = true;
-        return;
+    return add_mem_region(sub_regions, &nr_sub_regions, NR_SUB_REGIONS_MAX,
+                          base, limit, true, REGION_DATA);
+}
+#endif /* TFM_ISOLATION_LEVEL == 2 */
+
+/*
+ * Build the region tables from the static memory layout and the extra
+ * platform regions. Overlapping regions are a layout error.
+ */
+static int32_t collect_mem_regions(void)
+{
+    const struct mem_region_attr_t *extra_regions;
+    uint32_t i, nr_extra_regions = 0;
+
+    if ((add_mem_region(layout_regions, &nr_layout_regions, NR_LAYOUT_REGIONS,
+                        NS_DATA_START, NS_DATA_LIMIT, false,
+                        REGION_DATA) != SPM_SUCCESS) ||
+        (add_mem_region(layout_regions, &nr_layout_regions, NR_LAYOUT_REGIONS,
+                        NS_CODE_START, NS_CODE_LIMIT, false,
+                        REGION_CODE) != SPM_SUCCESS)) {
+        return SPM_ERROR_GENERIC;
     }
 
+#if TFM_ISOLATION_LEVEL == 1
+    if ((add_mem_region(layout_regions, &nr_layout_regions, NR_LAYOUT_REGIONS,
+                        S_DATA_START, S_DATA_LIMIT, true,
+                        REGION_DATA) != SPM_SUCCESS) ||
+        (add_mem_region(layout_regions, &nr_layout_regions, NR_LAYOUT_REGIONS,
+                        S_CODE_START, S_CODE_LIMIT, true,
+                        REGION_CODE) != SPM_SUCCESS)) {
+        return SPM_ERROR_GENERIC;
+    }
+#elif TFM_ISOLATION_LEVEL == 2
     /*
      * Treat the remaining parts in secure data section and secure code section
      * as privileged regions
      */
-    base = (uintptr_t)S_DATA_START;
-    limit = (uintptr_t)S_DATA_LIMIT;
-    if (check_address_range(p, s, base, limit) == SPM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = true;
-        p_attr->is_unpriv_rd_allow = false;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = true;
-        return;
+    if ((add_mem_region(layout_regions, &nr_layout_regions, NR_LAYOUT_REGIONS,
+                        S_DATA_START, S_DATA_LIMIT, true,
+                        REGION_PRIV_DATA) != SPM_SUCCESS) ||
+        (add_mem_region(layout_regions, &nr_layout_regions, NR_LAYOUT_REGIONS,
+                        S_CODE_START, S_CODE_LIMIT, true,
+                        REGION_PRIV_CODE) != SPM_SUCCESS)) {
+        return SPM_ERROR_GENERIC;
     }
 
-    base = (uintptr_t)S_CODE_START;
-    limit = (uintptr_t)S_CODE_LIMIT;
-    if (check_address_range(p, s, base, limit) == SPM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = false;
-        p_attr->is_unpriv_rd_allow = false;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = false;
-        return;
+    if (add_isolation_regions() != SPM_SUCCESS) {
+        return SPM_ERROR_GENERIC;
     }
-
-    p_attr->is_valid = false;
 #else
 #error "Cannot support current TF-M isolation level"
 #endif
+
+    extra_regions = tfm_hal_get_extra_mem_regions(&nr_extra_regions);
+    for (i = 0; extra_regions && (i < nr_extra_regions); i++) {
+        if (insert_mem_region(sub_regions, &nr_sub_regions, NR_SUB_REGIONS_MAX,
+                              &extra_regions[i]) != SPM_SUCCESS) {
+            return SPM_ERROR_GENERIC;
+        }
+    }
+
+    return SPM_SUCCESS;
 }
 
-void tfm_get_ns_mem_region_attr(const void *p, size_t s,
-                                struct mem_attr_info_t *p_attr)
+static void mem_region_init(void)
 {
-    p_attr->is_mpu_enabled = false;
+    struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
+
+    CRITICAL_SECTION_ENTER(cs_assert);
+
+    if (is_mem_region_init) {
+        CRITICAL_SECTION_LEAVE(cs_assert);
+        return;
+    }
+
+    is_mem_region_valid = (collect_mem_regions() == SPM_SUCCESS);
+    if (!is_mem_region_valid) {
+        nr_layout_regions = 0;
+        nr_sub_regions = 0;
+    }
+
+    is_mem_region_init = true;
+
+    CRITICAL_SECTION_LEAVE(cs_assert);
+}
+
+int32_t tfm_mem_region_init(void)
+{
+    mem_region_init();
+
+    return is_mem_region_valid ? SPM_SUCCESS : SPM_ERROR_GENERIC;
+}
+
+/* Index after the last region of a sorted table starting at or below addr */
+static uint32_t find_region_index(const struct mem_region_attr_t *regions,
+                                  uint32_t nr_regions, uintptr_t addr)
+{
+    uint32_t low = 0, high = nr_regions, mid;
+
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        if (regions[mid].base <= addr) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/* Binary search of the region of a sorted table containing the whole range */
+static const struct mem_region_attr_t *find_mem_region(
+                                    const struct mem_region_attr_t *regions,
+                                    uint32_t nr_regions,
+                                    const void *p, size_t s)
+{
+    uint32_t low = find_region_index(regions, nr_regions, (uintptr_t)p);
+
+    if (low == 0) {
+        return NULL;
+    }
+
+    if (check_address_range(p, s, regions[low - 1].base,
+                            regions[low - 1].limit) != SPM_SUCCESS) {
+        return NULL;
+    }
+
+    return &regions[low - 1];
+}
+
+/*
+ * Check whether a range overlaps any region of a sorted table. The regions
+ * don't overlap, so the last one starting at or below the end of the range
+ * has the highest limit of all the candidates.
+ */
+static bool is_range_overlapping(const struct mem_region_attr_t *regions,
+                                 uint32_t nr_regions,
+                                 const void *p, size_t s)
+{
+    uintptr_t end;
+    uint32_t idx;
+
+    if ((s == 0) || ((uintptr_t)p > UINTPTR_MAX - (s - 1))) {
+        return true;
+    }
+
+    end = (uintptr_t)p + s - 1;
+    idx = find_region_index(regions, nr_regions, end);
+
+    return (idx > 0) && (regions[idx - 1].limit >= (uintptr_t)p);
+}
+
+static const struct mem_region_attr_t *get_mem_region(const void *p, size_t s)
+{
+    const struct mem_region_attr_t *region;
+
+    if (!is_mem_region_init) {
+        mem_region_init();
+    }
+
+    if (!is_mem_region_valid) {
+        return NULL;
+    }
+
+    region = find_mem_region(sub_regions, nr_sub_regions, p, s);
+    if (region) {
+        return region;
+    }
+
+    /* A range partly inside a sub-region has no single set of attributes */
+    if (is_range_overlapping(sub_regions, nr_sub_regions, p, s)) {
+        return NULL;
+    }
+
+    return find_mem_region(layout_regions, nr_layout_regions, p, s);
+}
+
+void tfm_get_mem_region_security_attr(const void *p, size_t s,
+                                      struct security_attr_info_t *p_attr)
+{
+    const struct mem_region_attr_t *region = get_mem_region(p, s);
+
+    if (!region) {
+        p_attr->is_valid = false;
+        return;
+    }
+
     p_attr->is_valid = true;
+    p_attr->is_secure = region->is_secure;
+}
+
+void tfm_get_secure_mem_region_attr(const void *p, size_t s,
+                                    struct mem_attr_info_t *p_attr)
+{
+    const struct mem_region_attr_t *region = get_mem_region(p, s);
 
-    if (check_address_range(p, s, NS_DATA_START,
-                            NS_DATA_LIMIT) == SPM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = true;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = true;
-        p_attr->is_xn = true;
+    if (!region || !region->is_secure) {
+        p_attr->is_mpu_enabled = false;
+        p_attr->is_valid = false;
         return;
     }
 
-    if (check_address_range(p, s, NS_CODE_START,
-                            NS_CODE_LIMIT) == SPM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = false;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = false;
+    *p_attr = region->attr;
+}
+
+void tfm_get_ns_mem_region_attr(const void *p, size_t s,
+                                struct mem_attr_info_t *p_attr)
+{
+    const struct mem_region_attr_t *region = get_mem_region(p, s);
+
+    if (!region || region->is_secure) {
+        p_attr->is_mpu_enabled = false;
+        p_attr->is_valid = false;
         return;
     }
 
-    p_attr->is_valid = false;
+    *p_attr = region->attr;
 }
 
 static void security_attr_init(struct security_attr_info_t *p_attr)
@@ -378,6 +582,25 @@ static int32_t mem_attr_check(struct mem_attr_info_t attr, uint8_t flags)
     return secure_mem_attr_check(attr, flags);
 }
 
+#if NUM_MAILBOX_SHM_BUF > 0
+/* Check whether a non-secure access falls inside a validated shared region */
+static bool is_in_ns_shared_region(const void *p, size_t s, uint32_t flags)
+{
+    const struct mem_region_attr_t *region;
+
+    if (!(flags & MEM_CHECK_NONSECURE)) {
+        return false;
+    }
+
+    region = find_mem_region(ns_shared_regions, nr_ns_shared_regions, p, s);
+    if (!region) {
+        return false;
+    }
+
+    return (ns_mem_attr_check(region->attr, flags) == SPM_SUCCESS);
+}
+#endif
+
 int32_t tfm_has_access_to_region(const void *p, size_t s, uint32_t flags)
 {
     struct security_attr_info_t security_attr;
@@ -401,6 +624,12 @@ int32_t tfm_has_access_to_region(const void *p, size_t s, uint32_t flags)
         tfm_core_panic();
     }
 
+#if NUM_MAILBOX_SHM_BUF > 0
+    if (is_in_ns_shared_region(p, s, flags)) {
+        return SPM_SUCCESS;
+    }
+#endif
+
     security_attr_init(&security_attr);
 
     /* Retrieve security attributes of target memory region */
@@ -430,6 +659,40 @@ int32_t tfm_has_access_to_region(const void *p, size_t s, uint32_t flags)
     return mem_attr_check(mem_attr, flags);
 }
 
+int32_t tfm_register_ns_shared_region(const void *p, size_t s, uint32_t flags)
+{
+#if NUM_MAILBOX_SHM_BUF > 0
+    struct mem_region_attr_t region;
+
+    if (!(flags & MEM_CHECK_NONSECURE) || (s == 0)) {
+        return SPM_ERROR_GENERIC;
+    }
+
+    if (tfm_has_access_to_region(p, s, flags) != SPM_SUCCESS) {
+        return SPM_ERROR_GENERIC;
+    }
+
+    region.base = (uintptr_t)p;
+    region.limit = (uintptr_t)p + s - 1;
+    region.is_secure = false;
+    region.attr.is_xn = true;
+    region.attr.is_priv_rd_allow = true;
+    region.attr.is_unpriv_rd_allow = true;
+    region.attr.is_priv_wr_allow = !!(flags & MEM_CHECK_MPU_READWRITE);
+    region.attr.is_unpriv_wr_allow = !!(flags & MEM_CHECK_MPU_READWRITE);
+
+    /* Overlapping regions would make the lookup ambiguous */
+    return insert_mem_region(ns_shared_regions, &nr_ns_shared_regions,
+                             NUM_MAILBOX_SHM_BUF, &region);
+#else
+    (void)p;
+    (void)s;
+    (void)flags;
+
+    return SPM_ERROR_GENERIC;
+#endif
+}
+
 int32_t check_address_range(const void *p, size_t s,
                             uintptr_t region_start,
                             uintptr_t region_limit)
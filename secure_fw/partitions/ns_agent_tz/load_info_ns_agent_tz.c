@@ -33,9 +33,13 @@
 /* Entrypoint function declaration */
 extern void ns_agent_tz_main(void);
 
-/* Stack size must be aligned to satisfy platform alignment requirements */
+/*
+ * Stack size must be aligned to satisfy platform alignment requirements. The
+ * SPM re-uses this stack, including for the SFN partitions called directly.
+ */
 #define TFM_NS_AGENT_TZ_STACK_SIZE_ALIGNED \
-    ROUND_UP_TO_MULTIPLE(CONFIG_TFM_NS_AGENT_TZ_STACK_SIZE,\
+    ROUND_UP_TO_MULTIPLE(CONFIG_TFM_NS_AGENT_TZ_STACK_SIZE +       \
+                         SPM_DIRECT_CALL_STACK_SIZE,               \
                          TFM_LINKER_NS_AGENT_TZ_STACK_ALIGNMENT)
 
 /* Stack */
@@ -47,6 +51,7 @@ struct partition_tfm_sp_ns_agent_tz_load_info_t {
     /* per-partition variable length load data */
     uintptr_t                       stack_addr;
     uintptr_t                       heap_addr;
+    uintptr_t                       deps_bitmap;
 #if TFM_ISOLATION_LEVEL == 3
     struct asset_desc_t             assets[TFM_SP_NS_AGENT_NASSETS];
 #endif
@@ -80,6 +85,7 @@ const struct partition_tfm_sp_ns_agent_tz_load_info_t
     },
     .stack_addr                     = (uintptr_t)ns_agent_tz_stack,
     .heap_addr                      = 0,
+    .deps_bitmap                    = 0,
 #if TFM_ISOLATION_LEVEL == 3
     .assets                         = {
         {
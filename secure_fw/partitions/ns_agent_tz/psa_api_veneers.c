@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -45,6 +45,13 @@ psa_status_t tfm_psa_call_veneer(psa_handle_t handle,
                              in_vec, out_vec);
 }
 
+__tz_c_veneer
+psa_status_t tfm_psa_call_batch_veneer(psa_call_desc_t *calls,
+                                       uint32_t ctrl_param)
+{
+    return tfm_psa_call_batch_pack(calls, PARAM_SET_NS_VEC(ctrl_param));
+}
+
 /* Following veneers are only needed by connection-based services */
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
 __tz_c_veneer
@@ -39,6 +39,7 @@
 #pragma required = psa_panic
 #pragma required = psa_version
 #pragma required = tfm_psa_call_pack
+#pragma required = tfm_psa_call_batch_pack
 /* Following PSA APIs are only needed by connection-based services */
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
 #pragma required = psa_connect
@@ -154,6 +155,31 @@ psa_status_t tfm_psa_call_veneer(psa_handle_t handle,
     );
 }
 
+__tz_naked_veneer
+psa_status_t tfm_psa_call_batch_veneer(psa_call_desc_t *calls,
+                                       uint32_t ctrl_param)
+{
+    __ASM volatile(
+        SYNTAX_UNIFIED
+        "   ldr    r2, [sp]                                   \n"
+        "   ldr    r3, ="M2S(STACK_SEAL_PATTERN)"             \n"
+        "   cmp    r2, r3                                     \n"
+        "   bne    reent_panic6                               \n"
+        "   ldr    r3, ="M2S(NS_VEC_DESC_BIT)"                \n"
+        "   orrs   r1, r3                                     \n"
+        "   push   {r4, lr}                                   \n"
+        "   bl     "M2S(tfm_psa_call_batch_pack)"             \n"
+        "   bl     clear_caller_context                       \n"
+        "   pop    {r1, r2}                                   \n"
+        "   mov    lr, r2                                     \n"
+        "   mov    r4, r1                                     \n"
+        "   bxns   lr                                         \n"
+
+        "reent_panic6:                                        \n"
+        "   bl     psa_panic                                  \n"
+    );
+}
+
 /* Following veneers are only needed by connection-based services */
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
 
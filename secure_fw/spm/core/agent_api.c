@@ -11,6 +11,7 @@
 #include "fih.h"
 #include "internal_status_code.h"
 #include "spm.h"
+#include "spm_trace.h"
 #include "tfm_hal_isolation.h"
 #include "tfm_multi_core.h"
 #include "ffm/agent_api.h"
@@ -43,6 +44,9 @@ psa_status_t tfm_spm_agent_psa_call(psa_handle_t handle,
         return status;
     }
 
+    SPM_TRACE(SPM_TRACE_EVT_MAILBOX, curr_partition->p_ldinf->pid,
+              p_connection->service->p_ldinf->sid);
+
     status = spm_associate_call_params(p_connection, control, params->p_invecs, params->p_outvecs);
     if (status != PSA_SUCCESS) {
         return status;
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include "aapcs_local.h"
 #include "async.h"
+#include "boot_timeline.h"
 #include "critical_section.h"
 #include "compiler_ext_defs.h"
 #include "config_spm.h"
@@ -18,6 +19,8 @@
 #include "runtime_defs.h"
 #include "stack_watermark.h"
 #include "spm.h"
+#include "spm_service_stats.h"
+#include "spm_trace.h"
 #include "tfm_hal_isolation.h"
 #include "tfm_hal_platform.h"
 #include "tfm_rpc.h"
@@ -42,7 +45,8 @@ extern uintptr_t spm_boundary;
 struct context_ctrl_t *p_spm_thread_context;
 #else
 /* If ns_agent_tz isn't used, we need to provide a stack for SPM to use */
-static uint8_t spm_thread_stack[CONFIG_TFM_SPM_THREAD_STACK_SIZE] __aligned(8);
+static uint8_t spm_thread_stack[CONFIG_TFM_SPM_THREAD_STACK_SIZE +
+                                SPM_DIRECT_CALL_STACK_SIZE] __aligned(8);
 ARCH_CLAIM_CTXCTRL_INSTANCE(spm_thread_context,
                             spm_thread_stack,
                             sizeof(spm_thread_stack));
@@ -54,13 +58,14 @@ struct context_ctrl_t *p_spm_thread_context = &spm_thread_context;
 uintptr_t *partition_meta_indicator_pos;
 
 /*
- * Query the state of current thread.
+ * Query the state of a thread woken up by signals, and fetch the value to be
+ * returned to it. Called by the scheduler when the thread is picked to run.
  */
 static uint32_t query_state(struct thread_t *p_thrd, uint32_t *p_retval)
 {
     struct critical_section_t cs_signal = CRITICAL_SECTION_STATIC_INIT;
     struct partition_t *p_pt = NULL;
-    uint32_t state = p_thrd->state;
+    uint32_t state = THRD_STATE_BLOCK;
     psa_signal_t retval_signals = 0;
 
     /* Get current partition of thread. */
@@ -92,19 +97,15 @@ static uint32_t query_state(struct thread_t *p_thrd, uint32_t *p_retval)
             ((p_pt->signals_allowed & ASYNC_MSG_REPLY) != ASYNC_MSG_REPLY)) {
             p_pt->signals_asserted &= ~ASYNC_MSG_REPLY;
             *p_retval = (uint32_t)p_pt->reply_value;
+            SPM_TRACE(SPM_TRACE_EVT_CALL_EXIT, p_pt->p_ldinf->pid, *p_retval);
         } else {
             *p_retval = retval_signals;
+            SPM_TRACE(SPM_TRACE_EVT_WAKEUP, p_pt->p_ldinf->pid, retval_signals);
         }
 
         /* Clear 'signals_waiting' to indicate the component is not waiting. */
         p_pt->signals_waiting = 0;
         state = THRD_STATE_RET_VAL_AVAIL;
-    } else if (p_pt->signals_waiting != 0) {
-        /*
-         * If the thread is waiting some signals but none of them is asserted,
-         * block the thread.
-         */
-        state = THRD_STATE_BLOCK;
     }
 
     CRITICAL_SECTION_LEAVE(cs_signal);
@@ -165,13 +166,290 @@ static void prv_process_metadata(struct partition_t *p_pt)
     p_pt->p_metadata = (void *)p_rt_meta;
 }
 
+/* The priority of a partition given by its manifest */
+#define PARTITION_BASE_PRIORITY(p_pt)                                   \
+            TO_THREAD_PRIORITY(PARTITION_PRIORITY((p_pt)->p_ldinf->flags))
+
+/*
+ * Run the service partition at least at the priority of the client until the
+ * message is replied, so partitions with a priority between the two cannot
+ * delay the client. The effective priority of the client is used, hence the
+ * raise is passed along a chain of calls.
+ */
+static void inherit_priority(struct connection_t *p_connection)
+{
+    struct partition_t *p_client = p_connection->p_client;
+    struct partition_t *p_server = p_connection->service->partition;
+
+    if (!p_client ||
+        p_client->thrd.priority >= PARTITION_BASE_PRIORITY(p_server)) {
+        return;
+    }
+
+    p_connection->prio_inherited = true;
+    p_server->n_prio_inherited++;
+
+    if (p_client->thrd.priority < p_server->thrd.priority) {
+        thrd_set_priority(&p_server->thrd, p_client->thrd.priority);
+    }
+}
+
+/*
+ * The service partition keeps the highest inherited priority until all the
+ * messages which raised it are replied, then gets its own priority back. It
+ * keeps the bookkeeping to one counter per partition. Called by
+ * backend_replying(), which psa_reply() runs in a critical section.
+ */
+static void restore_priority(struct connection_t *p_connection)
+{
+    struct partition_t *p_server = p_connection->service->partition;
+
+    if (!p_connection->prio_inherited) {
+        return;
+    }
+
+    p_connection->prio_inherited = false;
+
+    if (--p_server->n_prio_inherited == 0) {
+        thrd_set_priority(&p_server->thrd, PARTITION_BASE_PRIORITY(p_server));
+    }
+}
+
+/* Put the message to the service queue and wake up the owner SP. */
+static psa_status_t messaging_enqueue(struct connection_t *p_connection)
+{
+    struct service_t *p_service = p_connection->service;
+    struct critical_section_t cs_msg = CRITICAL_SECTION_STATIC_INIT;
+
+    SPM_TRACE(SPM_TRACE_EVT_MESSAGING, p_service->partition->p_ldinf->pid,
+              p_service->p_ldinf->sid);
+    spm_stats_msg_queued(p_connection);
+
+    CRITICAL_SECTION_ENTER(cs_msg);
+    UNI_QUEUE_PUSH(p_service->p_msg_head, p_service->p_msg_tail,
+                   p_connection, p_handles);
+    inherit_priority(p_connection);
+    CRITICAL_SECTION_LEAVE(cs_msg);
+
+    /* Messages put. Update signals */
+    return backend_assert_signal(p_service->partition,
+                                 p_service->p_ldinf->signal);
+}
+
+#if CONFIG_TFM_SFN_DIRECT_CALL == 1
+/* SFN partitions which can be called directly, indexed by their set bit */
+#define DIRECT_PARTITION_MAX_NUM    32
+static struct partition_t *direct_partitions[DIRECT_PARTITION_MAX_NUM];
+
+/*
+ * Nesting level of direct calls. The SPM APIs called by a service running
+ * directly stay on the current stack and keep the scheduler locked.
+ */
+static uint32_t direct_call_depth;
+
+/*
+ * Find the SFN partitions which can run on the stack of their callers. The
+ * set of a partition holds itself and everything its services may call, and
+ * is zero if any of them needs a thread of its own or another boundary.
+ */
+static void direct_call_init(void)
+{
+    struct partition_t *p_pt;
+    struct service_t *p_srv;
+    uint32_t n = 0, i, j, deps;
+    bool changed;
+
+    UNI_LIST_FOREACH(p_pt, PARTITION_LIST_ADDR, next) {
+        p_pt->direct_deps = 0;
+
+        if (IS_IPC_MODEL(p_pt->p_ldinf) || IS_NS_AGENT(p_pt->p_ldinf) ||
+            (n >= DIRECT_PARTITION_MAX_NUM)) {
+            continue;
+        }
+
+#if TFM_ISOLATION_LEVEL > 1
+        if (tfm_hal_boundary_need_switch(spm_boundary, p_pt->boundary)) {
+            continue;
+        }
+#endif
+
+        p_pt->direct_deps = 1UL << n;
+        direct_partitions[n++] = p_pt;
+    }
+
+    do {
+        do {
+            changed = false;
+
+            for (i = 0; i < n; i++) {
+                p_pt = direct_partitions[i];
+                deps = p_pt->direct_deps;
+                if (deps == 0) {
+                    continue;
+                }
+
+                for (j = 0; j < p_pt->p_ldinf->ndeps; j++) {
+                    p_srv = tfm_spm_get_service_by_sid(
+                                            LOAD_INFO_DEPS(p_pt->p_ldinf)[j]);
+                    if (!p_srv || (p_srv->partition->direct_deps == 0)) {
+                        deps = 0;
+                        break;
+                    }
+                    deps |= p_srv->partition->direct_deps;
+                }
+
+                if (deps != p_pt->direct_deps) {
+                    p_pt->direct_deps = deps;
+                    changed = true;
+                }
+            }
+        } while (changed);
+
+        /*
+         * A partition calling itself, directly or through its dependencies,
+         * would be entered twice on the same stack. Keep it, and its callers,
+         * queued.
+         */
+        for (i = 0; i < n; i++) {
+            p_pt = direct_partitions[i];
+            for (j = 0; (p_pt->direct_deps != 0) &&
+                        (j < p_pt->p_ldinf->ndeps); j++) {
+                p_srv = tfm_spm_get_service_by_sid(
+                                            LOAD_INFO_DEPS(p_pt->p_ldinf)[j]);
+                if ((p_srv->partition == p_pt) ||
+                    (p_srv->partition->direct_deps & (1UL << i))) {
+                    p_pt->direct_deps = 0;
+                    changed = true;
+                }
+            }
+        }
+    } while (changed);
+}
+
+/*
+ * The thread of an SFN partition waits in psa_wait() between two messages.
+ * Once it has taken a message, the partition must not be entered directly
+ * until the message is replied.
+ */
+static bool sfn_partition_is_idle(const struct partition_t *p_pt)
+{
+    uint32_t i;
+
+    if ((p_pt->signals_waiting == 0) ||
+        (p_pt->signals_waiting & ASYNC_MSG_REPLY)) {
+        return false;
+    }
+
+    /* A direct call must not overtake the messages queued already */
+    for (i = 0; i < p_pt->p_ldinf->nservices; i++) {
+        if (p_pt->p_services[i].p_msg_head) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * The services run on the SPM stack, where backend_abi_entering_spm() has
+ * moved the Secure Partitions and which the TrustZone NS agent uses as its own.
+ * It must have room for the stacks declared by all the partitions the call may
+ * nest into.
+ */
+static bool direct_call_stack_fits(size_t stack_needed)
+{
+    uintptr_t sp = (uintptr_t)&stack_needed;
+
+    if ((sp <= SPM_THREAD_CONTEXT->sp_limit) ||
+        (sp > SPM_THREAD_CONTEXT->sp_base)) {
+        return false;
+    }
+
+    return (sp - SPM_THREAD_CONTEXT->sp_limit) >= stack_needed;
+}
+
+static bool direct_call_allowed(const struct connection_t *p_connection)
+{
+    const struct partition_t *p_client = p_connection->p_client;
+    uint32_t deps = p_connection->service->partition->direct_deps;
+    size_t stack_needed = 0;
+    uint32_t idx;
+
+    if ((deps == 0) || !p_client || p_connection->p_batch_status ||
+        is_tfm_rpc_msg(p_connection)) {
+        return false;
+    }
+
+    /* The service runs in the SPM boundary and the thread of the client */
+#if TFM_ISOLATION_LEVEL > 1
+    if (tfm_hal_boundary_need_switch(spm_boundary, p_client->boundary)) {
+        return false;
+    }
+#endif
+
+    /* Nested calls stay in the set checked by the outermost call */
+    if (direct_call_depth > 0) {
+        return true;
+    }
+
+    while (deps) {
+        idx = 31 - __CLZ(deps);
+        if (!sfn_partition_is_idle(direct_partitions[idx])) {
+            return false;
+        }
+        stack_needed += direct_partitions[idx]->p_ldinf->stack_size;
+        deps &= ~(1UL << idx);
+    }
+
+    return direct_call_stack_fits(stack_needed);
+}
+
+/*
+ * Run the service function as the SFN backend does: the service runs on the
+ * SPM stack in the thread of the client, and the reply is returned at once.
+ */
+static psa_status_t messaging_direct(struct connection_t *p_connection)
+{
+    struct partition_t *p_client = p_connection->p_client;
+    struct partition_t *p_target = p_connection->service->partition;
+    psa_status_t status;
+
+    SPM_TRACE(SPM_TRACE_EVT_MESSAGING, p_target->p_ldinf->pid,
+              p_connection->service->p_ldinf->sid);
+    spm_stats_msg_queued(p_connection);
+    spm_stats_msg_started(p_connection);
+
+    p_connection->is_direct = true;
+    p_connection->status = TFM_HANDLE_STATUS_ACTIVE;
+
+    direct_call_depth++;
+    SET_CURRENT_COMPONENT(p_target);
+    if (partition_meta_indicator_pos) {
+        *partition_meta_indicator_pos = (uintptr_t)p_target->p_metadata;
+    }
+
+    status = ((service_fn_t)p_connection->service->p_ldinf->sfn)(
+                                                        &p_connection->msg);
+    status = tfm_spm_partition_psa_reply(p_connection->msg.handle, status);
+
+    SET_CURRENT_COMPONENT(p_client);
+    if (partition_meta_indicator_pos) {
+        *partition_meta_indicator_pos = (uintptr_t)p_client->p_metadata;
+    }
+    direct_call_depth--;
+
+    SPM_TRACE(SPM_TRACE_EVT_CALL_EXIT, p_client->p_ldinf->pid, status);
+
+    return status;
+}
+#endif /* CONFIG_TFM_SFN_DIRECT_CALL == 1 */
+
 /*
  * Send message and wake up the SP who is waiting on message queue, block the
  * current thread and trigger scheduler.
  */
 psa_status_t backend_messaging(struct connection_t *p_connection)
 {
-    struct partition_t *p_owner = NULL;
     psa_signal_t signal = 0;
     psa_status_t ret = PSA_SUCCESS;
 
@@ -181,13 +459,18 @@ psa_status_t backend_messaging(struct connection_t *p_connection)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    p_owner = p_connection->service->partition;
-    signal = p_connection->service->p_ldinf->signal;
+#if CONFIG_TFM_SFN_DIRECT_CALL == 1
+    if (direct_call_allowed(p_connection)) {
+        return messaging_direct(p_connection);
+    }
 
-    UNI_LIST_INSERT_AFTER(p_owner, p_connection, p_handles);
+    /* Blocking is not possible while a service runs directly */
+    if (direct_call_depth > 0) {
+        tfm_core_panic();
+    }
+#endif
 
-    /* Messages put. Update signals */
-    ret = backend_assert_signal(p_owner, signal);
+    ret = messaging_enqueue(p_connection);
 
     /*
      * If it is a NS request via RPC, it is unnecessary to block current
@@ -207,20 +490,113 @@ psa_status_t backend_messaging(struct connection_t *p_connection)
     return ret;
 }
 
+psa_status_t backend_messaging_batch(struct connection_t *p_head,
+                                     psa_status_t status)
+{
+    /* Collects the result of the batch until the last reply */
+    p_head->p_client->reply_value = (uintptr_t)status;
+
+    /* Each request of the batch is traced as one call */
+    SPM_TRACE(SPM_TRACE_EVT_CALL_ENTER, p_head->p_client->p_ldinf->pid,
+              p_head->service->p_ldinf->sid);
+
+    return backend_messaging(p_head);
+}
+
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+psa_status_t backend_messaging_async(struct connection_t *p_connection)
+{
+    psa_status_t ret;
+
+    if (!p_connection || !p_connection->service ||
+        !p_connection->service->p_ldinf         ||
+        !p_connection->service->partition) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    p_connection->is_async = true;
+    ret = messaging_enqueue(p_connection);
+    p_connection->status = TFM_HANDLE_STATUS_ACTIVE;
+
+    return ret;
+}
+#endif /* CONFIG_TFM_ASYNC_CALL_API == 1 */
+
+/*
+ * Record the status of a batched request, then send the next request of the
+ * batch while the client keeps waiting. Wake up the client after the last.
+ */
+static psa_status_t replying_batch(struct connection_t *handle, int32_t status)
+{
+    struct partition_t *client = handle->p_client;
+    struct connection_t *p_next = handle->p_batch_next;
+
+    *handle->p_batch_status = status;
+    handle->p_batch_status = NULL;
+    handle->p_batch_next = NULL;
+
+    /*
+     * The wake-up of the client after the last request records one more
+     * exit, which has no call to close.
+     */
+    SPM_TRACE(SPM_TRACE_EVT_CALL_EXIT, client->p_ldinf->pid, status);
+
+    if ((status < PSA_SUCCESS) &&
+        ((psa_status_t)client->reply_value == PSA_SUCCESS)) {
+        client->reply_value = (uintptr_t)status;
+    }
+
+    if (p_next) {
+        SPM_TRACE(SPM_TRACE_EVT_CALL_ENTER, client->p_ldinf->pid,
+                  p_next->service->p_ldinf->sid);
+        p_next->status = TFM_HANDLE_STATUS_ACTIVE;
+        return messaging_enqueue(p_next);
+    }
+
+    return backend_assert_signal(client, ASYNC_MSG_REPLY);
+}
+
 psa_status_t backend_replying(struct connection_t *handle, int32_t status)
 {
     struct partition_t *client = handle->p_client;
 
+    SPM_TRACE(SPM_TRACE_EVT_REPLYING, handle->service->partition->p_ldinf->pid,
+              handle->service->p_ldinf->sid);
+
+    restore_priority(handle);
+
+#if CONFIG_TFM_SFN_DIRECT_CALL == 1
+    if (handle->is_direct) {
+        /* Returned by messaging_direct() to the client */
+        handle->is_direct = false;
+        return status;
+    }
+#endif
+
+    if (handle->p_batch_status) {
+        return replying_batch(handle, status);
+    }
+
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+    if (handle->is_async) {
+        /* Queued until the client collects it with psa_get_reply() */
+        handle->reply_value = (uintptr_t)status;
+        UNI_QUEUE_PUSH(client->p_handles, client->p_handles_tail,
+                       handle, p_handles);
+        return backend_assert_signal(client, ASYNC_CALL_REPLY);
+    }
+#endif
+
     if (is_tfm_rpc_msg(handle)) {
         /*
-         * Add to the list of outstanding responses.
-         * Note that we use the partition's p_handles pointer.
-         * This assumes that partitions using the agent API will process all requests
-         * asynchronously and will not also provide services of their own.
+         * Add to the queue of outstanding responses of the client partition.
+         * Services keep their own message queues, so partitions using the
+         * agent API can still provide services of their own.
          */
         handle->reply_value = (uintptr_t)status;
         handle->msg.rhandle = handle;
-        UNI_LIST_INSERT_AFTER(client, handle, p_handles);
+        UNI_QUEUE_PUSH(client->p_handles, client->p_handles_tail,
+                       handle, p_handles);
         return backend_assert_signal(handle->p_client, ASYNC_MSG_REPLY);
     } else {
         handle->p_client->reply_value = (uintptr_t)status;
@@ -228,13 +604,49 @@ psa_status_t backend_replying(struct connection_t *handle, int32_t status)
     }
 }
 
+#ifdef CONFIG_TFM_BOOT_TIMELINE
+static bool boot_timeline_done;
+
+/*
+ * Record the Partitions running at boot, until an NS Agent runs for the
+ * first time, which is the NS entry.
+ */
+static void boot_timeline_schedule(const struct partition_t *p_next)
+{
+    if (boot_timeline_done) {
+        return;
+    }
+
+    if (IS_NS_AGENT(p_next->p_ldinf)) {
+        boot_timeline_done = true;
+        boot_timeline_checkpoint(BTL_STAGE_SPM, BTL_CP_JUMP,
+                                 (uint16_t)p_next->p_ldinf->pid);
+    } else {
+        boot_timeline_checkpoint(BTL_STAGE_SPM, BTL_CP_PART_INIT,
+                                 (uint16_t)p_next->p_ldinf->pid);
+    }
+}
+#define BOOT_TIMELINE_SCHEDULE(p_next)  boot_timeline_schedule(p_next)
+#else
+#define BOOT_TIMELINE_SCHEDULE(p_next)
+#endif
+
 extern void common_sfn_thread(void *param);
 
+static thrd_fn_t partition_entry(const struct partition_t *p_pt)
+{
+    if (IS_IPC_MODEL(p_pt->p_ldinf)) {
+        /* IPC Partition */
+        return POSITION_TO_ENTRY(p_pt->p_ldinf->entry, thrd_fn_t);
+    }
+
+    /* SFN Partition */
+    return (thrd_fn_t)common_sfn_thread;
+}
+
 static thrd_fn_t partition_init(struct partition_t *p_pt,
                                 uint32_t service_setting, uint32_t *param)
 {
-    thrd_fn_t thrd_entry;
-
     (void)param;
     SPM_ASSERT(p_pt);
 
@@ -249,16 +661,18 @@ static thrd_fn_t partition_init(struct partition_t *p_pt,
         p_pt->signals_allowed |= ASYNC_MSG_REPLY;
     }
 
-    UNI_LISI_INIT_NODE(p_pt, p_handles);
-
-    if (IS_IPC_MODEL(p_pt->p_ldinf)) {
-        /* IPC Partition */
-        thrd_entry = POSITION_TO_ENTRY(p_pt->p_ldinf->entry, thrd_fn_t);
-    } else {
-        /* SFN Partition */
-        thrd_entry = (thrd_fn_t)common_sfn_thread;
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+    /* Secure Partitions wait for replies of psa_call_async() */
+    if (!IS_NS_AGENT(p_pt->p_ldinf)) {
+        p_pt->signals_allowed |= ASYNC_CALL_REPLY;
     }
-    return thrd_entry;
+#endif
+
+    p_pt->p_handles = NULL;
+    p_pt->p_handles_tail = NULL;
+    p_pt->n_prio_inherited = 0;
+
+    return partition_entry(p_pt);
 }
 
 #ifdef CONFIG_TFM_USE_TRUSTZONE
@@ -314,6 +728,17 @@ void backend_init_comp_assuredly(struct partition_t *p_pt, uint32_t service_sett
 
     prv_process_metadata(p_pt);
 
+    /*
+     * A lazy start Partition stays in THRD_STATE_CREATING until the first
+     * signal is asserted to it, see backend_assert_signal().
+     */
+    if (IS_LAZY_START(p_pldi) && !IS_NS_AGENT(p_pldi)) {
+        return;
+    }
+
+    SPM_TRACE(SPM_TRACE_EVT_START, p_pldi->pid,
+              IS_NS_AGENT(p_pldi) ? SPM_TRACE_START_NS_AGENT : 0);
+
     thrd_start(&p_pt->thrd, thrd_entry, THRD_GENERAL_EXIT, (void *)param);
 }
 
@@ -336,6 +761,10 @@ uint32_t backend_system_run(void)
     arch_seal_thread_stack(ARCH_CTXCTRL_ALLOCATED_PTR(SPM_THREAD_CONTEXT));
 #endif
 
+#if CONFIG_TFM_SFN_DIRECT_CALL == 1
+    direct_call_init();
+#endif
+
     /* Init thread callback function. */
     thrd_set_query_callback(query_state);
 
@@ -345,6 +774,8 @@ uint32_t backend_system_run(void)
     p_cur_pt = TO_CONTAINER(CURRENT_THREAD->p_context_ctrl,
                             struct partition_t, ctx_ctrl);
 
+    BOOT_TIMELINE_SCHEDULE(p_cur_pt);
+
     FIH_CALL(tfm_hal_activate_boundary, fih_rc, p_cur_pt->p_ldinf, p_cur_pt->boundary);
     if (fih_not_eq(fih_rc, fih_int_encode(TFM_HAL_SUCCESS))) {
         tfm_core_panic();
@@ -366,7 +797,9 @@ psa_signal_t backend_wait_signals(struct partition_t *p_pt, psa_signal_t signals
 
     ret = p_pt->signals_asserted & signals;
     if (ret == (psa_signal_t)0) {
+        /* Take the thread out of the run queue until a signal arrives. */
         p_pt->signals_waiting = signals;
+        thrd_set_state(&p_pt->thrd, THRD_STATE_BLOCK);
     }
 
     CRITICAL_SECTION_LEAVE(cs_signal);
@@ -386,7 +819,23 @@ psa_status_t backend_assert_signal(struct partition_t *p_pt, psa_signal_t signal
     CRITICAL_SECTION_ENTER(cs_signal);
     p_pt->signals_asserted |= signal;
 
-    if (p_pt->signals_asserted & p_pt->signals_waiting) {
+    if (IS_LAZY_START(p_pt->p_ldinf) &&
+        (p_pt->thrd.state == THRD_STATE_CREATING)) {
+        /*
+         * First signal to a lazy start Partition, start it now. The signal
+         * stays asserted and is picked up by the first psa_wait() after the
+         * Partition initialization.
+         */
+        SPM_TRACE(SPM_TRACE_EVT_START, p_pt->p_ldinf->pid,
+                  SPM_TRACE_START_LAZY);
+        thrd_start(&p_pt->thrd, partition_entry(p_pt), THRD_GENERAL_EXIT, NULL);
+        ret = STATUS_NEED_SCHEDULE;
+    } else if (p_pt->signals_asserted & p_pt->signals_waiting) {
+        /*
+         * Put the waiting thread back into the run queue. The return value
+         * is delivered by the scheduler when the thread gets picked.
+         */
+        thrd_set_state(&p_pt->thrd, THRD_STATE_RET_VAL_AVAIL);
         ret = STATUS_NEED_SCHEDULE;
     }
     CRITICAL_SECTION_LEAVE(cs_signal);
@@ -408,6 +857,14 @@ uint64_t backend_abi_entering_spm(void)
     }
 #endif
 
+#if CONFIG_TFM_SFN_DIRECT_CALL == 1
+    /* Called by a service running directly, the SPM stack is in use already */
+    if (direct_call_depth > 0) {
+        AAPCS_DUAL_U32_SET(spm_stack_info, 0, 0);
+        return AAPCS_DUAL_U32_AS_U64(spm_stack_info);
+    }
+#endif
+
     /*
      * Check if caller stack is within SPM stack. If not, then stack needs to
      * switch. Otherwise, return zeros.
@@ -431,6 +888,20 @@ uint32_t backend_abi_leaving_spm(uint32_t result)
 
     spm_handle_programmer_errors(result);
 
+#if CONFIG_TFM_SFN_DIRECT_CALL == 1
+    /*
+     * Keep the scheduler locked until the outermost direct call returns. No
+     * other partition runs meanwhile, so the scheduling latency is bounded
+     * by the longest service called directly.
+     */
+    if (direct_call_depth > 0) {
+        if (result == STATUS_NEED_SCHEDULE) {
+            arch_attempt_schedule();
+        }
+        return result;
+    }
+#endif
+
     /* Release scheduler lock and check the record of schedule attempt. */
     sched_attempted = arch_release_sched_lock();
 
@@ -464,6 +935,10 @@ uint64_t ipc_schedule(void)
     p_part_next = GET_THRD_OWNER(pth_next);
 
     if (pth_next != NULL && p_part_curr != p_part_next) {
+        SPM_TRACE(SPM_TRACE_EVT_SCHEDULE, p_part_next->p_ldinf->pid,
+                  p_part_curr->p_ldinf->pid);
+        BOOT_TIMELINE_SCHEDULE(p_part_next);
+
         /* Check if there is enough room on stack to save more context */
         if ((p_curr_ctx->sp_limit +
                 sizeof(struct tfm_additional_context_t)) > __get_PSP()) {
@@ -476,6 +951,8 @@ uint64_t ipc_schedule(void)
          */
         if (tfm_hal_boundary_need_switch(p_part_curr->boundary,
                                          p_part_next->boundary)) {
+            SPM_TRACE(SPM_TRACE_EVT_BOUNDARY, p_part_next->p_ldinf->pid,
+                      p_part_next->boundary);
             FIH_CALL(tfm_hal_activate_boundary, fih_rc,
                      p_part_next->p_ldinf, p_part_next->boundary);
             if (fih_not_eq(fih_rc, fih_int_encode(TFM_HAL_SUCCESS))) {
@@ -9,6 +9,7 @@
  */
 
 #include <stdint.h>
+#include "boot_timeline.h"
 #include "compiler_ext_defs.h"
 #include "current.h"
 #include "runtime_defs.h"
@@ -21,6 +22,8 @@
 #include "psa/error.h"
 #include "psa/service.h"
 #include "spm.h"
+#include "spm_service_stats.h"
+#include "spm_trace.h"
 
 /* SFN Partition state */
 #define SFN_PARTITION_STATE_NOT_INITED        0
@@ -50,9 +53,15 @@ psa_status_t backend_messaging(struct connection_t *p_connection)
     p_target = p_connection->service->partition;
     p_target->p_handles = p_connection;
 
+    SPM_TRACE(SPM_TRACE_EVT_MESSAGING, p_target->p_ldinf->pid,
+              p_connection->service->p_ldinf->sid);
+    spm_stats_msg_queued(p_connection);
+
     SET_CURRENT_COMPONENT(p_target);
 
     if (p_target->state == SFN_PARTITION_STATE_NOT_INITED) {
+        SPM_TRACE(SPM_TRACE_EVT_START, p_target->p_ldinf->pid,
+                  SPM_TRACE_START_LAZY);
         if (p_target->p_ldinf->entry != 0) {
             status = ((sfn_init_fn_t)p_target->p_ldinf->entry)(NULL);
             /* Negative value indicates errors. */
@@ -72,6 +81,9 @@ psa_status_t backend_messaging(struct connection_t *p_connection)
 
 psa_status_t backend_replying(struct connection_t *handle, int32_t status)
 {
+    SPM_TRACE(SPM_TRACE_EVT_REPLYING, handle->service->partition->p_ldinf->pid,
+              handle->service->p_ldinf->sid);
+
     SET_CURRENT_COMPONENT(handle->p_client);
 
     /*
@@ -103,6 +115,14 @@ static uint32_t spm_thread_fn(uint32_t param)
             continue;
         }
 
+        /* Lazy start Partitions are initialized by the first message */
+        if (IS_LAZY_START(p_part->p_ldinf)) {
+            continue;
+        }
+
+        SPM_TRACE(SPM_TRACE_EVT_START, p_part->p_ldinf->pid, 0);
+        BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_SPM, BTL_CP_PART_INIT,
+                                 (uint16_t)p_part->p_ldinf->pid);
         SET_CURRENT_COMPONENT(p_part);
 
         if (p_part->p_ldinf->entry != 0) {
@@ -117,6 +137,12 @@ static uint32_t spm_thread_fn(uint32_t param)
 
     SET_CURRENT_COMPONENT(p_curr);
 
+    /* The NS Agent enters NSPE right after */
+    SPM_TRACE(SPM_TRACE_EVT_START, p_curr->p_ldinf->pid,
+              SPM_TRACE_START_NS_AGENT);
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_SPM, BTL_CP_JUMP,
+                             (uint16_t)p_curr->p_ldinf->pid);
+
     return param;
 }
 
@@ -22,6 +22,7 @@
 #include "load/spm_load_api.h"
 #include "ffm/backend.h"
 #include "internal_status_code.h"
+#include "spm_trace.h"
 
 extern uintptr_t spm_boundary;
 
@@ -77,6 +78,8 @@ uint32_t tfm_flih_prepare_depriv_flih(struct partition_t *p_owner_sp,
      */
     SET_CURRENT_COMPONENT(p_owner_sp);
 
+    SPM_TRACE(SPM_TRACE_EVT_FLIH, p_owner_sp->p_ldinf->pid, flih_func);
+
     flih_ctx_ctrl.sp_limit = sp_limit;
     flih_ctx_ctrl.sp       = ctx_stack;
 
@@ -121,21 +124,29 @@ const struct irq_load_info_t *get_irq_info_for_signal(
                                     const struct partition_load_info_t *p_ldinf,
                                     psa_signal_t signal)
 {
-    size_t i;
+    uint32_t idx;
     const struct irq_load_info_t *irq_info;
 
     if (!IS_ONLY_ONE_BIT_IN_UINT32(signal)) {
         return NULL;
     }
 
-    irq_info = LOAD_INFO_IRQ(p_ldinf);
-    for (i = 0; i < p_ldinf->nirqs; i++) {
-        if (irq_info[i].signal == signal) {
-            return &irq_info[i];
-        }
+    /*
+     * The manifest tool assigns the signals from the most significant bit in
+     * the order of the IRQ load info, so the IRQ of signal (1 << (31 - i))
+     * is at index i.
+     */
+    idx = __CLZ(signal);
+    if (idx >= p_ldinf->nirqs) {
+        return NULL;
     }
 
-    return NULL;
+    irq_info = &LOAD_INFO_IRQ(p_ldinf)[idx];
+    if (irq_info->signal != signal) {
+        return NULL;
+    }
+
+    return irq_info;
 }
 
 void spm_handle_interrupt(void *p_pt, const struct irq_load_info_t *p_ildi)
@@ -154,6 +165,8 @@ void spm_handle_interrupt(void *p_pt, const struct irq_load_info_t *p_ildi)
         tfm_core_panic();
     }
 
+    SPM_TRACE(SPM_TRACE_EVT_IRQ, p_ildi->pid, p_ildi->source);
+
     if (p_ildi->flih_func == NULL) {
         /* SLIH Model Handling */
         tfm_hal_irq_disable(p_ildi->source);
@@ -161,10 +174,12 @@ void spm_handle_interrupt(void *p_pt, const struct irq_load_info_t *p_ildi)
     } else {
         /* FLIH Model Handling */
 #if TFM_ISOLATION_LEVEL == 1
+        SPM_TRACE(SPM_TRACE_EVT_FLIH, p_ildi->pid, p_ildi->flih_func);
         flih_result = p_ildi->flih_func();
 #else
         if (!tfm_hal_boundary_need_switch(spm_boundary,
                                          p_part->boundary)) {
+            SPM_TRACE(SPM_TRACE_EVT_FLIH, p_ildi->pid, p_ildi->flih_func);
             flih_result = p_ildi->flih_func();
         } else {
             flih_result = tfm_flih_deprivileged_handling(
@@ -5,15 +5,18 @@
  *
  */
 
+#include "boot_timeline.h"
 #include "build_config_check.h"
 #include "internal_status_code.h"
 #include "fih.h"
 #include "tfm_boot_data.h"
 #include "memory_symbols.h"
 #include "spm.h"
+#include "spm_service_stats.h"
 #include "tfm_hal_isolation.h"
 #include "tfm_hal_platform.h"
 #include "tfm_spm_log.h"
+#include "spm_trace.h"
 #include "tfm_version.h"
 #include "tfm_plat_otp.h"
 #include "tfm_plat_provisioning.h"
@@ -67,6 +70,9 @@ static fih_int tfm_core_init(void)
     /* Configures architecture */
     tfm_arch_config_extensions();
 
+    SPM_TRACE_INIT();
+    spm_service_stats_init();
+
     SPMLOG_INFMSG("\033[1;34m[Sec Thread] Secure image initializing!\033[0m\r\n");
 
     SPMLOG_DBGMSGVAL("TF-M isolation level is: ", TFM_ISOLATION_LEVEL);
@@ -93,6 +99,8 @@ int main(void)
 
     fih_int fih_rc = FIH_FAILURE;
 
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_SPM, BTL_CP_START, 0);
+
     /* set Main Stack Pointer limit */
     tfm_arch_set_msplim(SPM_BOOT_STACK_TOP);
 
@@ -18,6 +18,7 @@
 #include "psa/lifecycle.h"
 #include "psa/service.h"
 #include "spm.h"
+#include "spm_service_stats.h"
 #include "tfm_arch.h"
 #include "load/partition_defs.h"
 #include "load/service_defs.h"
@@ -144,23 +145,18 @@ psa_status_t tfm_spm_partition_psa_get(psa_signal_t signal, psa_msg_t *msg)
     }
 
     if (signal == ASYNC_MSG_REPLY) {
-        struct connection_t **pr_handle_iter, **prev = NULL;
         struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
 
-        /* Remove tail of the list, which is the first item added */
+        /* Take the head of the reply queue, which is the first item added */
         CRITICAL_SECTION_ENTER(cs_assert);
-        if (!partition->p_handles) {
+        UNI_QUEUE_POP(partition->p_handles, partition->p_handles_tail,
+                      handle, p_handles);
+        if (!handle) {
             tfm_core_panic();
         }
-        UNI_LIST_FOREACH_NODE_PNODE(pr_handle_iter, handle,
-                                    partition, p_handles) {
-            prev = pr_handle_iter;
-        }
-        handle = *prev;
-        UNI_LIST_REMOVE_NODE_BY_PNODE(prev, p_handles);
         ret = handle->reply_value;
         /* Clear the signal if there are no more asynchronous responses waiting */
-        if (!partition->p_handles) {
+        if (UNI_QUEUE_IS_EMPTY(partition->p_handles)) {
             partition->signals_asserted &= ~ASYNC_MSG_REPLY;
         }
         CRITICAL_SECTION_LEAVE(cs_assert);
@@ -171,6 +167,7 @@ psa_status_t tfm_spm_partition_psa_get(psa_signal_t signal, psa_msg_t *msg)
          */
         handle = spm_get_handle_by_signal(partition, signal);
         if (handle) {
+            spm_stats_msg_started(handle);
             ret = PSA_SUCCESS;
         } else {
             return PSA_ERROR_DOES_NOT_EXIST;
@@ -282,6 +279,8 @@ psa_status_t tfm_spm_partition_psa_reply(psa_handle_t msg_handle,
      * to mailbox. Also need to check implementation when secure context is
      * involved.
      */
+    spm_stats_msg_replied(handle);
+
     CRITICAL_SECTION_ENTER(cs_assert);
     ret = backend_replying(handle, ret);
     CRITICAL_SECTION_LEAVE(cs_assert);
@@ -296,6 +295,13 @@ psa_status_t tfm_spm_partition_psa_reply(psa_handle_t msg_handle,
     }
 #endif
 
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+    /* Likewise for psa_call_async(), until psa_get_reply() collects it. */
+    if (handle->is_async) {
+        return ret;
+    }
+#endif
+
     /*
      * When the asynchronous agent API is not used or when in SFN model, free
      * the connection handle immediately.
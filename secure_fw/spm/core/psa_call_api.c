@@ -8,13 +8,18 @@
  *
  */
 
+#include "async.h"
 #include "config_impl.h"
 #include "critical_section.h"
 #include "ffm/backend.h"
 #include "ffm/psa_api.h"
+#include "internal_status_code.h"
+#include "tfm_arch.h"
 #include "tfm_hal_isolation.h"
 #include "tfm_psa_call_pack.h"
 #include "utilities.h"
+#include "lists.h"
+#include "spm_trace.h"
 
 extern struct service_t *stateless_services_ref_tbl[];
 
@@ -168,6 +173,10 @@ psa_status_t tfm_spm_client_psa_call(psa_handle_t handle,
         return status;
     }
 
+    SPM_TRACE(SPM_TRACE_EVT_CALL_ENTER,
+              (GET_CURRENT_COMPONENT())->p_ldinf->pid,
+              p_connection->service->p_ldinf->sid);
+
     status = spm_associate_call_params(p_connection, ctrl_param, inptr, outptr);
     if (status != PSA_SUCCESS) {
         if (IS_STATIC_HANDLE(handle)) {
@@ -178,3 +187,227 @@ psa_status_t tfm_spm_client_psa_call(psa_handle_t handle,
 
     return backend_messaging(p_connection);
 }
+
+psa_status_t spm_validate_call_batch(psa_call_desc_t *calls,
+                                     uint32_t ctrl_param)
+{
+    fih_int  fih_rc    = FIH_FAILURE;
+    uint32_t ns_access = 0;
+    size_t   num       = PARAM_UNPACK_BATCH_NUM(ctrl_param);
+    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
+
+    if ((num == 0) || (num > CONFIG_TFM_PSA_CALL_BATCH_MAX_NUM)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    if (PARAM_IS_NS_VEC(ctrl_param)) {
+        ns_access = TFM_HAL_ACCESS_NS;
+    }
+
+    /*
+     * The status of each request is written back into the descriptors. It is
+     * a PROGRAMMER ERROR if the descriptor array is invalid or not read-write.
+     */
+    FIH_CALL(tfm_hal_memory_check, fih_rc,
+             curr_partition->boundary, (uintptr_t)calls,
+             num * sizeof(psa_call_desc_t),
+             TFM_HAL_ACCESS_READWRITE | ns_access);
+    if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+
+#if CONFIG_TFM_SPM_BACKEND_IPC == 1
+static psa_status_t spm_prepare_batched_call(struct connection_t **p_connection,
+                                             const psa_call_desc_t *desc,
+                                             uint32_t batch_ctrl,
+                                             int32_t client_id)
+{
+    uint32_t ctrl_param;
+    psa_status_t status;
+
+    if ((desc->type    > PSA_CALL_TYPE_MAX) ||
+        (desc->type    < PSA_CALL_TYPE_MIN) ||
+        (desc->in_len  > PSA_MAX_IOVEC)     ||
+        (desc->out_len > PSA_MAX_IOVEC)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    ctrl_param = PARAM_PACK(desc->type, desc->in_len, desc->out_len);
+    if (PARAM_IS_NS_VEC(batch_ctrl)) {
+        ctrl_param = PARAM_SET_NS_VEC(ctrl_param);
+    }
+
+    status = spm_get_connection(p_connection, desc->handle, client_id);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* A connection carries one request of the batch at a time. */
+    if ((*p_connection)->p_batch_status) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    status = spm_associate_call_params(*p_connection, ctrl_param,
+                                       desc->in_vec, desc->out_vec);
+    if (status != PSA_SUCCESS) {
+        if (IS_STATIC_HANDLE(desc->handle)) {
+            spm_free_connection(*p_connection);
+        }
+        return status;
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_spm_client_psa_call_batch(psa_call_desc_t *calls,
+                                           uint32_t ctrl_param)
+{
+    struct connection_t *p_head = NULL, *p_tail = NULL;
+    struct connection_t *p_connection;
+    psa_call_desc_t desc;
+    psa_status_t status, batch_status = PSA_SUCCESS;
+    bool ns_caller = tfm_spm_is_ns_caller();
+    int32_t client_id;
+    size_t i;
+
+    status = spm_validate_call_batch(calls, ctrl_param);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    client_id = tfm_spm_get_client_id(ns_caller);
+
+    /*
+     * Prepare all the requests in the caller context. The backend then
+     * dispatches them one after another without returning to the caller.
+     */
+    for (i = 0; i < PARAM_UNPACK_BATCH_NUM(ctrl_param); i++) {
+        /* Work on a copy as the client can change the descriptor meanwhile */
+        spm_memcpy(&desc, &calls[i], sizeof(desc));
+
+        status = spm_prepare_batched_call(&p_connection, &desc,
+                                          ctrl_param, client_id);
+        if (status != PSA_SUCCESS) {
+            /* Secure Partitions panic on PROGRAMMER ERROR as in psa_call */
+            spm_handle_programmer_errors(status);
+
+            calls[i].status = status;
+            if (batch_status == PSA_SUCCESS) {
+                batch_status = status;
+            }
+            continue;
+        }
+
+        p_connection->p_batch_status = &calls[i].status;
+        UNI_QUEUE_PUSH(p_head, p_tail, p_connection, p_batch_next);
+    }
+
+    if (UNI_QUEUE_IS_EMPTY(p_head)) {
+        return batch_status;
+    }
+
+    return backend_messaging_batch(p_head, batch_status);
+}
+
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+psa_handle_t tfm_spm_client_psa_call_async(psa_handle_t handle,
+                                           uint32_t ctrl_param,
+                                           const psa_invec *inptr,
+                                           psa_outvec *outptr)
+{
+    struct connection_t *p_connection;
+    int32_t client_id;
+    psa_status_t status;
+
+    /*
+     * NS clients go through the agent API to call asynchronously. The error
+     * is returned to the NS agent, which is not panicked.
+     */
+    if (tfm_spm_is_ns_caller()) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    client_id = tfm_spm_get_client_id(false);
+
+    status = spm_get_connection(&p_connection, handle, client_id);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    SPM_TRACE(SPM_TRACE_EVT_CALL_ENTER,
+              (GET_CURRENT_COMPONENT())->p_ldinf->pid,
+              p_connection->service->p_ldinf->sid);
+
+    status = spm_associate_call_params(p_connection, ctrl_param, inptr, outptr);
+    if (status != PSA_SUCCESS) {
+        if (IS_STATIC_HANDLE(handle)) {
+            spm_free_connection(p_connection);
+        }
+        return status;
+    }
+
+    status = backend_messaging_async(p_connection);
+    if (status == STATUS_NEED_SCHEDULE) {
+        /* The service may preempt the client, the request handle is kept */
+        (void)arch_attempt_schedule();
+    } else if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    return p_connection->msg.handle;
+}
+
+psa_status_t tfm_spm_client_psa_get_reply(psa_handle_t *p_request)
+{
+    struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
+    struct partition_t *partition = GET_CURRENT_COMPONENT();
+    struct connection_t *p_connection;
+    fih_int fih_rc = FIH_FAILURE;
+    psa_status_t status;
+
+    /* The replies queued to an NS agent belong to the agent API */
+    if (tfm_spm_is_ns_caller()) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    FIH_CALL(tfm_hal_memory_check, fih_rc,
+             partition->boundary, (uintptr_t)p_request,
+             sizeof(*p_request), TFM_HAL_ACCESS_READWRITE);
+    if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /* Take the oldest reply */
+    CRITICAL_SECTION_ENTER(cs_assert);
+    UNI_QUEUE_POP(partition->p_handles, partition->p_handles_tail,
+                  p_connection, p_handles);
+    if (UNI_QUEUE_IS_EMPTY(partition->p_handles)) {
+        partition->signals_asserted &= ~ASYNC_CALL_REPLY;
+    }
+    CRITICAL_SECTION_LEAVE(cs_assert);
+
+    /* It is a PROGRAMMER ERROR if no reply is pending */
+    if (!p_connection) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    *p_request = p_connection->msg.handle;
+    status = (psa_status_t)p_connection->reply_value;
+    p_connection->is_async = false;
+
+    SPM_TRACE(SPM_TRACE_EVT_CALL_EXIT, partition->p_ldinf->pid,
+              (uint32_t)status);
+
+    if (p_connection->status == TFM_HANDLE_STATUS_TO_FREE) {
+        spm_free_connection(p_connection);
+    } else {
+        p_connection->status = TFM_HANDLE_STATUS_IDLE;
+    }
+
+    return status;
+}
+#endif /* CONFIG_TFM_ASYNC_CALL_API == 1 */
+#endif /* CONFIG_TFM_SPM_BACKEND_IPC == 1 */
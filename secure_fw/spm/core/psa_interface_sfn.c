@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -13,6 +13,8 @@
 #include "ffm/backend.h"
 #include "ffm/psa_api.h"
 #include "psa/client.h"
+#include "utilities.h"
+#include "spm_trace.h"
 
 uint32_t psa_framework_version(void)
 {
@@ -59,9 +61,58 @@ psa_status_t tfm_psa_call_pack(psa_handle_t handle, uint32_t ctrl_param,
         spm_handle_programmer_errors(stat);
     }
 
+    SPM_TRACE(SPM_TRACE_EVT_CALL_EXIT, p_client->p_ldinf->pid, stat);
+
     return (psa_status_t)stat;
 }
 
+psa_status_t tfm_psa_call_batch_pack(psa_call_desc_t *calls,
+                                     uint32_t ctrl_param)
+{
+    psa_call_desc_t desc;
+    psa_status_t stat, batch_stat;
+    uint32_t call_ctrl;
+    size_t i;
+
+    if (__get_active_exc_num() != EXC_NUM_THREAD_MODE) {
+        /* PSA APIs must be called from Thread mode */
+        tfm_core_panic();
+    }
+
+    batch_stat = spm_validate_call_batch(calls, ctrl_param);
+    if (batch_stat != PSA_SUCCESS) {
+        spm_handle_programmer_errors(batch_stat);
+        return batch_stat;
+    }
+
+    /* Services are called directly, so dispatch the requests one by one. */
+    for (i = 0; i < PARAM_UNPACK_BATCH_NUM(ctrl_param); i++) {
+        spm_memcpy(&desc, &calls[i], sizeof(desc));
+
+        if ((desc.type    > PSA_CALL_TYPE_MAX) ||
+            (desc.type    < PSA_CALL_TYPE_MIN) ||
+            (desc.in_len  > PSA_MAX_IOVEC)     ||
+            (desc.out_len > PSA_MAX_IOVEC)) {
+            stat = PSA_ERROR_PROGRAMMER_ERROR;
+            spm_handle_programmer_errors(stat);
+        } else {
+            call_ctrl = PARAM_PACK(desc.type, desc.in_len, desc.out_len);
+            if (PARAM_IS_NS_VEC(ctrl_param)) {
+                call_ctrl = PARAM_SET_NS_VEC(call_ctrl);
+            }
+            stat = tfm_psa_call_pack(desc.handle, call_ctrl,
+                                     desc.in_vec, desc.out_vec);
+        }
+
+        calls[i].status = stat;
+        if ((stat < PSA_SUCCESS) && (batch_stat == PSA_SUCCESS)) {
+            batch_stat = stat;
+        }
+    }
+
+    return batch_stat;
+}
+
 size_t psa_read(psa_handle_t msg_handle, uint32_t invec_idx,
                 void *buffer, size_t num_bytes)
 {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -37,6 +37,13 @@ __naked psa_status_t tfm_psa_call_pack_svc(psa_handle_t handle,
                    "bx      lr                                 \n");
 }
 
+__naked psa_status_t tfm_psa_call_batch_pack_svc(psa_call_desc_t *calls,
+                                                 uint32_t ctrl_param)
+{
+    __asm volatile("svc     "M2S(TFM_SVC_PSA_CALL_BATCH)"      \n"
+                   "bx      lr                                 \n");
+}
+
 __naked psa_signal_t psa_wait_svc(psa_signal_t signal_mask, uint32_t timeout)
 {
     __asm volatile("svc     "M2S(TFM_SVC_PSA_WAIT)"            \n"
@@ -90,6 +97,23 @@ __naked void psa_clear_svc(void)
 }
 #endif /* CONFIG_TFM_DOORBELL_API == 1 */
 
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+__naked psa_handle_t psa_call_async_svc(psa_handle_t handle,
+                                        uint32_t ctrl_param,
+                                        const psa_invec *in_vec,
+                                        psa_outvec *out_vec)
+{
+    __asm volatile("svc     "M2S(TFM_SVC_PSA_CALL_ASYNC)"      \n"
+                   "bx      lr                                 \n");
+}
+
+__naked psa_status_t psa_get_reply_svc(psa_handle_t *p_request)
+{
+    __asm volatile("svc     "M2S(TFM_SVC_PSA_GET_REPLY)"       \n"
+                   "bx      lr                                 \n");
+}
+#endif /* CONFIG_TFM_ASYNC_CALL_API == 1 */
+
 __naked void psa_panic_svc(void)
 {
     __asm volatile("svc     "M2S(TFM_SVC_PSA_PANIC)"           \n"
@@ -192,6 +216,7 @@ const struct psa_api_tbl_t psa_api_svc = {
                                 psa_reply_svc,
                                 psa_panic_svc,
                                 psa_rot_lifecycle_state_svc,
+                                tfm_psa_call_batch_pack_svc,
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
                                 psa_connect_svc,
                                 psa_close_svc,
@@ -201,6 +226,10 @@ const struct psa_api_tbl_t psa_api_svc = {
                                 psa_notify_svc,
                                 psa_clear_svc,
 #endif /* CONFIG_TFM_DOORBELL_API == 1 */
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+                                psa_call_async_svc,
+                                psa_get_reply_svc,
+#endif /* CONFIG_TFM_ASYNC_CALL_API == 1 */
 #if CONFIG_TFM_FLIH_API == 1 || CONFIG_TFM_SLIH_API == 1
                                 psa_irq_enable_svc,
                                 psa_irq_disable_svc,
@@ -59,6 +59,14 @@ psa_status_t tfm_psa_call_pack_thread_fn_call(psa_handle_t handle,
     TFM_THREAD_FN_CALL_ENTRY(tfm_spm_client_psa_call);
 }
 
+__naked
+__section(".psa_interface_thread_fn_call")
+psa_status_t tfm_psa_call_batch_pack_thread_fn_call(psa_call_desc_t *calls,
+                                                    uint32_t ctrl_param)
+{
+    TFM_THREAD_FN_CALL_ENTRY(tfm_spm_client_psa_call_batch);
+}
+
 __naked
 __section(".psa_interface_thread_fn_call")
 psa_signal_t psa_wait_thread_fn_call(psa_signal_t signal_mask, uint32_t timeout)
@@ -120,6 +128,25 @@ void psa_clear_thread_fn_call(void)
 }
 #endif /* CONFIG_TFM_DOORBELL_API == 1 */
 
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+__naked
+__section(".psa_interface_thread_fn_call")
+psa_handle_t psa_call_async_thread_fn_call(psa_handle_t handle,
+                                           uint32_t ctrl_param,
+                                           const psa_invec *in_vec,
+                                           psa_outvec *out_vec)
+{
+    TFM_THREAD_FN_CALL_ENTRY(tfm_spm_client_psa_call_async);
+}
+
+__naked
+__section(".psa_interface_thread_fn_call")
+psa_status_t psa_get_reply_thread_fn_call(psa_handle_t *p_request)
+{
+    TFM_THREAD_FN_CALL_ENTRY(tfm_spm_client_psa_get_reply);
+}
+#endif /* CONFIG_TFM_ASYNC_CALL_API == 1 */
+
 __naked
 __section(".psa_interface_thread_fn_call")
 void psa_panic_thread_fn_call(void)
@@ -264,6 +291,7 @@ const struct psa_api_tbl_t psa_api_thread_fn_call = {
                                 psa_reply_thread_fn_call,
                                 psa_panic_thread_fn_call,
                                 psa_rot_lifecycle_state_thread_fn_call,
+                                tfm_psa_call_batch_pack_thread_fn_call,
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
                                 psa_connect_thread_fn_call,
                                 psa_close_thread_fn_call,
@@ -273,6 +301,10 @@ const struct psa_api_tbl_t psa_api_thread_fn_call = {
                                 psa_notify_thread_fn_call,
                                 psa_clear_thread_fn_call,
 #endif /* CONFIG_TFM_DOORBELL_API == 1 */
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+                                psa_call_async_thread_fn_call,
+                                psa_get_reply_thread_fn_call,
+#endif /* CONFIG_TFM_ASYNC_CALL_API == 1 */
 #if CONFIG_TFM_FLIH_API == 1 || CONFIG_TFM_SLIH_API == 1
                                 psa_irq_enable_thread_fn_call,
                                 psa_irq_disable_thread_fn_call,
@@ -9,6 +9,7 @@
  */
 #include "ffm/psa_api.h"
 #include "spm.h"
+#include "spm_service_stats.h"
 #include "utilities.h"
 #include "tfm_hal_isolation.h"
 
@@ -78,6 +79,7 @@ size_t tfm_spm_partition_psa_read(psa_handle_t msg_handle, uint32_t invec_idx,
 
     /* Update the data size read */
     handle->invec_accessed[invec_idx] += bytes;
+    spm_stats_bytes_read(handle, bytes);
 
     return bytes;
 }
@@ -207,6 +209,7 @@ psa_status_t tfm_spm_partition_psa_write(psa_handle_t msg_handle, uint32_t outve
 
     /* Update the data size written */
     handle->outvec_written[outvec_idx] += num_bytes;
+    spm_stats_bytes_written(handle, num_bytes);
 
     return PSA_SUCCESS;
 }
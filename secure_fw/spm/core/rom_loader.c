@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2023, Arm Limited. All rights reserved.
  * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -14,6 +14,7 @@
 #include "memory_symbols.h"
 #include "region_defs.h"
 #include "spm.h"
+#include "spm_sid_hash.h"
 #include "tfm_hal_interrupt.h"
 #include "tfm_plat_defs.h"
 #include "utilities.h"
@@ -108,16 +109,16 @@ struct partition_t *load_a_partition_assuredly(struct partition_head_t *head)
 }
 
 uint32_t load_services_assuredly(struct partition_t *p_partition,
-                                 struct service_head_t *services_listhead,
+                                 struct service_t **sid_hash_tbl,
                                  struct service_t **stateless_services_ref_tbl,
                                  size_t ref_tbl_size)
 {
-    uint32_t i, serv_ldflags, hidx, service_setting = 0;
+    uint32_t i, serv_ldflags, hidx, slot, service_setting = 0;
     struct service_t *services;
     const struct partition_load_info_t *p_ptldinf;
     const struct service_load_info_t *p_servldinf;
 
-    if (!p_partition || !services_listhead) {
+    if (!p_partition || !sid_hash_tbl) {
         tfm_core_panic();
     }
 
@@ -129,10 +130,14 @@ uint32_t load_services_assuredly(struct partition_t *p_partition,
      * The loop won't go in the NULL case.
      */
     services = tfm_allocate_service_assuredly(p_ptldinf->nservices);
+    p_partition->p_services = services;
     for (i = 0; i < p_ptldinf->nservices && services; i++) {
         services[i].p_ldinf = &p_servldinf[i];
         services[i].partition = p_partition;
-        services[i].next = NULL;
+#if CONFIG_TFM_SPM_BACKEND_IPC == 1
+        services[i].p_msg_head = NULL;
+        services[i].p_msg_tail = NULL;
+#endif
 
         BACKEND_SERVICE_SET(service_setting, &p_servldinf[i]);
 
@@ -155,7 +160,12 @@ uint32_t load_services_assuredly(struct partition_t *p_partition,
             stateless_services_ref_tbl[hidx] = &services[i];
         }
 
-        UNI_LIST_INSERT_AFTER(services_listhead, &services[i], next);
+        /* The build-time hash guarantees each SID a unique slot */
+        slot = SPM_SID_HASH(p_servldinf[i].sid);
+        if (sid_hash_tbl[slot]) {
+            tfm_core_panic();
+        }
+        sid_hash_tbl[slot] = &services[i];
     }
 
     return service_setting;
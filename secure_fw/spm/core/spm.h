@@ -11,6 +11,7 @@
 #ifndef __SPM_H__
 #define __SPM_H__
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "config_impl.h"
 #include "config_spm.h"
@@ -18,14 +19,25 @@
 #include "tfm_arch.h"
 #include "lists.h"
 #include "thread.h"
+#include "tfm_psa_call_batch.h"
 #include "psa/service.h"
 #include "load/partition_defs.h"
 #include "load/interrupt_defs.h"
+#ifdef CONFIG_TFM_SPM_SERVICE_STATS
+#include "tfm_diag_defs.h"
+#endif
 
 #define TFM_HANDLE_STATUS_IDLE          0 /* Handle created             */
 #define TFM_HANDLE_STATUS_ACTIVE        1 /* Handle in use              */
 #define TFM_HANDLE_STATUS_TO_FREE       2 /* Free the handle            */
 
+#if CONFIG_TFM_SFN_DIRECT_CALL == 1
+/* The SPM stack also holds the stacks of the SFN partitions called directly */
+#define SPM_DIRECT_CALL_STACK_SIZE      CONFIG_TFM_SFN_DIRECT_CALL_STACK_SIZE
+#else
+#define SPM_DIRECT_CALL_STACK_SIZE      0
+#endif
+
 /* The mask used for timeout values */
 #define PSA_TIMEOUT_MASK        PSA_BLOCK
 
@@ -95,8 +107,21 @@ struct connection_t {
     uint32_t iovec_status;                   /* MM-IOVEC status                */
 #endif
 #if CONFIG_TFM_SPM_BACKEND_IPC == 1
-    struct connection_t *p_handles;          /* Handle(s) link                 */
+    struct connection_t *p_handles;          /* Message or reply queue link    */
     uintptr_t reply_value;                   /* Result of this operation, if aynchronous */
+    struct connection_t *p_batch_next;       /* Next request of the same batch */
+    psa_status_t *p_batch_status;            /* Status of the batched request */
+    bool prio_inherited;                     /* Service runs at client priority */
+#endif
+#if CONFIG_TFM_SFN_DIRECT_CALL == 1
+    bool is_direct;                          /* Run in the thread of the caller */
+#endif
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+    bool is_async;                           /* Reply collected by psa_get_reply */
+#endif
+#ifdef CONFIG_TFM_SPM_SERVICE_STATS
+    uint32_t ts_queued;                      /* Message delivered to service   */
+    uint32_t ts_started;                     /* Message taken by psa_get()     */
 #endif
 };
 
@@ -113,10 +138,16 @@ struct partition_t {
     struct context_ctrl_t              ctx_ctrl;
     struct thread_t                    thrd;            /* IPC model */
     uintptr_t                          reply_value;
+    struct connection_t                *p_handles_tail; /* Reply queue tail */
+    uint32_t                           n_prio_inherited;/* Raising messages */
+#if CONFIG_TFM_SFN_DIRECT_CALL == 1
+    uint32_t                           direct_deps;     /* Direct call set  */
+#endif
 #else
     uint32_t                           state;           /* SFN model */
 #endif
     struct connection_t                *p_handles;
+    struct service_t                   *p_services;     /* Service array */
     struct partition_t                 *next;
 };
 
@@ -124,7 +155,13 @@ struct partition_t {
 struct service_t {
     const struct service_load_info_t *p_ldinf;     /* Service load info      */
     struct partition_t *partition;                 /* Owner of the service   */
-    struct service_t *next;                        /* For list operation     */
+#if CONFIG_TFM_SPM_BACKEND_IPC == 1
+    struct connection_t *p_msg_head;               /* Oldest pending message */
+    struct connection_t *p_msg_tail;               /* Newest pending message */
+#endif
+#ifdef CONFIG_TFM_SPM_SERVICE_STATS
+    struct tfm_diag_service_stats_t stats;         /* Running statistics     */
+#endif
 };
 
 /**
@@ -144,19 +181,23 @@ psa_status_t spm_validate_connection(const struct connection_t *p_connection);
 /* Panic if invalid connection is given. */
 void spm_free_connection(struct connection_t *p_connection);
 
+#ifdef CONFIG_TFM_CONNECTION_POOL_ENABLE
+/* Get a snapshot of the connection pool statistics. */
+void spm_get_connection_pool_stats(struct tfm_diag_conn_pool_stats_t *p_stats);
+#endif
+
 /******************** Partition management functions *************************/
 
 #if CONFIG_TFM_SPM_BACKEND_IPC == 1
 /*
- * Lookup and grab the last spotted handles containing the message
- * by the given signal. Only ONE signal bit can be accepted in 'signal',
+ * Take the oldest message from the queue of the service represented by
+ * the given signal. Only ONE signal bit can be accepted in 'signal',
  * multiple bits lead to 'no matched handles found to that signal'.
  *
  * Returns NULL if no handles matched with the given signal.
  * Returns an internal handle instance if spotted, the instance
- * is moved out of partition handles. Partition available signals
- * also get updated based on the count of handles with given signal
- * still in the partition handles.
+ * is moved out of the service message queue. The signal is cleared
+ * from the partition asserted signals when the queue becomes empty.
  */
 struct connection_t *spm_get_handle_by_signal(struct partition_t *p_ptn,
                                               psa_signal_t signal);
@@ -242,6 +283,13 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
                                        const psa_invec     *inptr,
                                        psa_outvec          *outptr);
 
+/*
+ * Check the descriptor array of a batch is accessible by the caller and the
+ * number of descriptors is in range.
+ */
+psa_status_t spm_validate_call_batch(psa_call_desc_t *calls,
+                                     uint32_t ctrl_param);
+
 /**
  * \brief                   Check the client version according to
  *                          version policy
@@ -5,123 +5,170 @@
  *
  */
 
+#include <stdint.h>
 #include "critical_section.h"
 #include "internal_status_code.h"
 #include "spm.h"
-#include "tfm_pools.h"
+#include "utilities.h"
 #include "load/service_defs.h"
 
 #if !(defined CONFIG_TFM_CONN_HANDLE_MAX_NUM) || (CONFIG_TFM_CONN_HANDLE_MAX_NUM == 0)
 #error "CONFIG_TFM_CONN_HANDLE_MAX_NUM must be defined and not zero."
 #endif
 
-/* Pools */
-TFM_POOL_DECLARE(connection_pool, sizeof(struct connection_t),
-                 CONFIG_TFM_CONN_HANDLE_MAX_NUM);
-
 /*********************** Connection handle conversion APIs *******************/
 
-#define CONVERSION_FACTOR_BITOFFSET    3
-#define CONVERSION_FACTOR_VALUE        (1 << CONVERSION_FACTOR_BITOFFSET)
-/* Set 32 as the maximum */
-#define CONVERSION_FACTOR_VALUE_MAX    0x20
+/*
+ * A user handle is composed of the slot index of the connection in the pool
+ * and the generation of that slot:
+ *
+ *  handle = ((generation << CONN_HANDLE_INDEX_BITS) | index) +
+ *           CLIENT_HANDLE_VALUE_MIN
+ *
+ * The generation of a slot is bumped each time the slot is freed, so a handle
+ * of a freed connection does not match the slot any more even if the slot is
+ * reused. Both fields stay below STATIC_HANDLE_INDICATOR_OFFSET.
+ */
+#define CONN_HANDLE_INDEX_BITS         16
+#define CONN_HANDLE_INDEX_MASK         ((1UL << CONN_HANDLE_INDEX_BITS) - 1)
+#define CONN_HANDLE_GEN_BITS           13
+#define CONN_HANDLE_GEN_MASK           ((1UL << CONN_HANDLE_GEN_BITS) - 1)
 
-#if CONVERSION_FACTOR_VALUE > CONVERSION_FACTOR_VALUE_MAX
-#error "CONVERSION FACTOR OUT OF RANGE"
+#if CONFIG_TFM_CONN_HANDLE_MAX_NUM > (1UL << CONN_HANDLE_INDEX_BITS)
+#error "CONFIG_TFM_CONN_HANDLE_MAX_NUM exceeds the handle index range."
 #endif
 
-static uint32_t loop_index;
+/* Connection with its pool management data */
+struct conn_slot_info_t {
+    struct connection_t conn;             /* Must be the first member       */
+    union conn_slot_t *next_free;         /* Next free slot                 */
+    uint16_t generation;                  /* Bumped when the slot is freed  */
+};
+
+/*
+ * Slots are padded to a power-of-two stride, so a pointer is converted to a
+ * slot index with a shift instead of a division.
+ */
+#define CONN_SLOT_INFO_SIZE            sizeof(struct conn_slot_info_t)
+#define CONN_SLOT_SHIFT                                                     \
+    ((CONN_SLOT_INFO_SIZE <= 64)   ? 6 :                                    \
+     (CONN_SLOT_INFO_SIZE <= 128)  ? 7 :                                    \
+     (CONN_SLOT_INFO_SIZE <= 256)  ? 8 :                                    \
+     (CONN_SLOT_INFO_SIZE <= 512)  ? 9 : 10)
+#define CONN_SLOT_STRIDE               (1UL << CONN_SLOT_SHIFT)
+
+union conn_slot_t {
+    struct conn_slot_info_t info;
+    uint8_t stride[CONN_SLOT_STRIDE];
+};
+
+/* Pools */
+static union conn_slot_t connection_pool[CONFIG_TFM_CONN_HANDLE_MAX_NUM];
+static union conn_slot_t *conn_free_head;
+static struct tfm_diag_conn_pool_stats_t conn_stats;
+
+#define CONN_TO_SLOT(p)    ((union conn_slot_t *)(p))
+#define SLOT_INDEX(p)      \
+    (((uintptr_t)(p) - (uintptr_t)connection_pool) >> CONN_SLOT_SHIFT)
 
 /*
  * A connection instance connection_t allocated inside SPM is actually a memory
- * address among the connection pool. Return this connection to the client directly
- * exposes information of secure memory address. In this case, converting the
- * connection into another handle value does not represent the memory address
- * to avoid exposing secure memory directly to clients.
- *
- * This function converts the connection instance into another value by scaling
- * the connection in pool offset, the converted value is named as a user handle.
- *
- * The formula:
- *  handle =      (p_connection - POOL_START) * CONVERSION_FACTOR_VALUE +
- *                CLIENT_HANDLE_VALUE_MIN + loop_index
- * where:
- *  CONVERSION_FACTOR_VALUE = 1 << CONVERSION_FACTOR_BITOFFSET, and should not
- *  exceed CONVERSION_FACTOR_VALUE_MAX.
- *
- *  p_connection    in RANGE[POOL_START, POOL_END]
- *  handle          in RANGE[CLIENT_HANDLE_VALUE_MIN, 0x3FFFFFFF]
- *  loop_index      in RANGE[0, CONVERSION_FACTOR_VALUE - 1]
- *
- *  note:
- *  loop_index is used to promise same connection instance is converted into
- *  different user handles in short time.
+ * address among the connection pool. Return this connection to the client
+ * directly exposes information of secure memory address. In this case,
+ * converting the connection into a slot index and generation does not
+ * represent the memory address to avoid exposing secure memory directly to
+ * clients.
  */
 psa_handle_t connection_to_handle(struct connection_t *p_connection)
 {
-    psa_handle_t handle;
-
-    loop_index = (loop_index + 1) % CONVERSION_FACTOR_VALUE;
-    handle = (psa_handle_t)((((uintptr_t)p_connection -
-                  (uintptr_t)connection_pool) << CONVERSION_FACTOR_BITOFFSET) +
-                  CLIENT_HANDLE_VALUE_MIN + loop_index);
+    union conn_slot_t *p_slot = CONN_TO_SLOT(p_connection);
 
-    return handle;
+    return (psa_handle_t)((((uint32_t)p_slot->info.generation <<
+                             CONN_HANDLE_INDEX_BITS) |
+                            (uint32_t)SLOT_INDEX(p_slot)) +
+                          CLIENT_HANDLE_VALUE_MIN);
 }
 
 /*
  * This function converts a user handle into a corresponded connection instance.
- * The converted value is validated before returning, an invalid handle instance
- * is returned as NULL.
- *
- * The formula:
- *  p_connection =    ((handle - CLIENT_HANDLE_VALUE_MIN) /
- *                    CONVERSION_FACTOR_VALUE) + POOL_START
- * where:
- *  CONVERSION_FACTOR_VALUE = 1 << CONVERSION_FACTOR_BITOFFSET, and should not
- *  exceed CONVERSION_FACTOR_VALUE_MAX.
- *
- *  p_connection    in RANGE[POOL_START, POOL_END]
- *  handle          in RANGE[CLIENT_HANDLE_VALUE_MIN, 0x3FFFFFFF]
- *  loop_index      in RANGE[0, CONVERSION_FACTOR_VALUE - 1]
+ * The handle is validated before returning, an out of range or stale handle is
+ * returned as NULL.
  */
 struct connection_t *handle_to_connection(psa_handle_t handle)
 {
-    struct connection_t *p_connection;
+    struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
+    union conn_slot_t *p_slot;
+    uint32_t value, index;
 
     if (handle == PSA_NULL_HANDLE) {
         return NULL;
     }
 
-    p_connection = (struct connection_t *)((((uintptr_t)handle -
-                    CLIENT_HANDLE_VALUE_MIN) >> CONVERSION_FACTOR_BITOFFSET) +
-                    (uintptr_t)connection_pool);
+    value = (uint32_t)handle - CLIENT_HANDLE_VALUE_MIN;
+    index = value & CONN_HANDLE_INDEX_MASK;
+    if (index >= CONFIG_TFM_CONN_HANDLE_MAX_NUM) {
+        return NULL;
+    }
+
+    p_slot = &connection_pool[index];
+    if ((value >> CONN_HANDLE_INDEX_BITS) != p_slot->info.generation) {
+        CRITICAL_SECTION_ENTER(cs_assert);
+        conn_stats.stale_handles++;
+        CRITICAL_SECTION_LEAVE(cs_assert);
+        return NULL;
+    }
 
-    return p_connection;
+    return &p_slot->info.conn;
 }
 
 /* Service handle management functions */
 void spm_init_connection_space(void)
 {
-    if (tfm_pool_init(connection_pool,
-                      POOL_BUFFER_SIZE(connection_pool),
-                      sizeof(struct connection_t),
-                      CONFIG_TFM_CONN_HANDLE_MAX_NUM) != PSA_SUCCESS) {
+    uint32_t i;
+
+    if (sizeof(union conn_slot_t) != CONN_SLOT_STRIDE) {
         tfm_core_panic();
     }
+
+    /* Buffer should be BSS cleared but clear it again */
+    spm_memset(connection_pool, 0, sizeof(connection_pool));
+    spm_memset(&conn_stats, 0, sizeof(conn_stats));
+
+    conn_free_head = NULL;
+    for (i = CONFIG_TFM_CONN_HANDLE_MAX_NUM; i > 0; i--) {
+        connection_pool[i - 1].info.next_free = conn_free_head;
+        conn_free_head = &connection_pool[i - 1];
+    }
+
+    conn_stats.capacity = CONFIG_TFM_CONN_HANDLE_MAX_NUM;
 }
 
 struct connection_t *spm_allocate_connection(void)
 {
-    /* Get buffer for handle list structure from handle pool */
-    return (struct connection_t *)tfm_pool_alloc(connection_pool);
+    union conn_slot_t *p_slot = conn_free_head;
+
+    if (!p_slot) {
+        return NULL;
+    }
+
+    conn_free_head = p_slot->info.next_free;
+    p_slot->info.next_free = NULL;
+
+    conn_stats.in_use++;
+    if (conn_stats.in_use > conn_stats.high_water) {
+        conn_stats.high_water = conn_stats.in_use;
+    }
+
+    return &p_slot->info.conn;
 }
 
 psa_status_t spm_validate_connection(const struct connection_t *p_connection)
 {
-    /* Check the handle address is valid */
-    if (is_valid_chunk_data_in_pool(connection_pool,
-                                    (uint8_t *)p_connection) != true) {
+    uintptr_t offset = (uintptr_t)p_connection - (uintptr_t)connection_pool;
+
+    /* Check the handle address is a slot in the pool */
+    if ((offset >= sizeof(connection_pool)) ||
+        (offset & (CONN_SLOT_STRIDE - 1))) {
         return SPM_ERROR_GENERIC;
     }
 
@@ -130,12 +177,29 @@ psa_status_t spm_validate_connection(const struct connection_t *p_connection)
 
 void spm_free_connection(struct connection_t *p_connection)
 {
+    union conn_slot_t *p_slot = CONN_TO_SLOT(p_connection);
     struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
 
     SPM_ASSERT(p_connection != NULL);
 
     CRITICAL_SECTION_ENTER(cs_assert);
+    /* Invalidate the handles of this connection before reuse */
+    p_slot->info.generation =
+                (p_slot->info.generation + 1) & CONN_HANDLE_GEN_MASK;
     /* Back handle buffer to pool */
-    tfm_pool_free(connection_pool, p_connection);
+    p_slot->info.next_free = conn_free_head;
+    conn_free_head = p_slot;
+    conn_stats.in_use--;
+    CRITICAL_SECTION_LEAVE(cs_assert);
+}
+
+void spm_get_connection_pool_stats(struct tfm_diag_conn_pool_stats_t *p_stats)
+{
+    struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
+
+    SPM_ASSERT(p_stats != NULL);
+
+    CRITICAL_SECTION_ENTER(cs_assert);
+    *p_stats = conn_stats;
     CRITICAL_SECTION_LEAVE(cs_assert);
 }
@@ -12,6 +12,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "bitops.h"
+#include "boot_timeline.h"
+#include "cmsis_compiler.h"
 #include "config_impl.h"
 #include "config_spm.h"
 #include "critical_section.h"
@@ -39,59 +41,82 @@
 #include "load/service_defs.h"
 #include "load/asset_defs.h"
 #include "load/spm_load_api.h"
+#include "spm_sid_hash.h"
 #include "tfm_nspm.h"
 
-/* Partition and service runtime data list head/runtime data table */
-static struct service_head_t services_listhead;
+/* Services indexed by the build-time SID hash slot, filled at loading */
+static struct service_t *sid_hash_tbl[SPM_SID_HASH_SIZE];
 struct service_t *stateless_services_ref_tbl[STATIC_HANDLE_NUM_LIMIT];
 
 /* Partition management functions */
 
 /* This API is only used in IPC backend. */
 #if CONFIG_TFM_SPM_BACKEND_IPC == 1
+/*
+ * Service signals of a partition are consecutive bits assigned in the order
+ * of the services, so the service is indexed by the signal bit position.
+ */
+static struct service_t *spm_get_service_by_signal(struct partition_t *p_ptn,
+                                                   psa_signal_t signal)
+{
+    struct service_t *p_service;
+    psa_signal_t first_signal;
+    uint32_t idx;
+
+    if (!p_ptn->p_services || !IS_ONLY_ONE_BIT_IN_UINT32(signal)) {
+        return NULL;
+    }
+
+    first_signal = p_ptn->p_services[0].p_ldinf->signal;
+    if (signal < first_signal) {
+        return NULL;
+    }
+
+    idx = __CLZ(first_signal) - __CLZ(signal);
+    if (idx >= p_ptn->p_ldinf->nservices) {
+        return NULL;
+    }
+
+    p_service = &p_ptn->p_services[idx];
+    if (p_service->p_ldinf->signal != signal) {
+        return NULL;
+    }
+
+    return p_service;
+}
+
 struct connection_t *spm_get_handle_by_signal(struct partition_t *p_ptn,
                                               psa_signal_t signal)
 {
-    struct connection_t *p_handle_iter;
-    struct connection_t **pr_handle_iter, **last_found_handle_holder = NULL;
+    struct connection_t *p_handle = NULL;
+    struct service_t *p_service;
     struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
-    uint32_t nr_found_msgs = 0;
 
     CRITICAL_SECTION_ENTER(cs_assert);
 
-    /* Return the last found message which applies a FIFO mechanism. */
-    UNI_LIST_FOREACH_NODE_PNODE(pr_handle_iter, p_handle_iter,
-                                p_ptn, p_handles) {
-        if (p_handle_iter->service->p_ldinf->signal == signal) {
-            last_found_handle_holder = pr_handle_iter;
-            nr_found_msgs++;
-        }
-    }
-
-    if (last_found_handle_holder) {
-        p_handle_iter = *last_found_handle_holder;
-        UNI_LIST_REMOVE_NODE_BY_PNODE(last_found_handle_holder, p_handles);
+    p_service = spm_get_service_by_signal(p_ptn, signal);
+    if (p_service) {
+        UNI_QUEUE_POP(p_service->p_msg_head, p_service->p_msg_tail,
+                      p_handle, p_handles);
 
-        if (nr_found_msgs == 1) {
+        if (UNI_QUEUE_IS_EMPTY(p_service->p_msg_head)) {
             p_ptn->signals_asserted &= ~signal;
         }
     }
 
     CRITICAL_SECTION_LEAVE(cs_assert);
 
-    return p_handle_iter;
+    return p_handle;
 }
 #endif /* CONFIG_TFM_SPM_BACKEND_IPC == 1 */
 
 struct service_t *tfm_spm_get_service_by_sid(uint32_t sid)
 {
-    struct service_t *p_prev, *p_curr;
+    struct service_t *p_service = sid_hash_tbl[SPM_SID_HASH(sid)];
 
-    UNI_LIST_FOREACH_NODE_PREV(p_prev, p_curr, &services_listhead, next) {
-        if (p_curr->p_ldinf->sid == sid) {
-            UNI_LIST_MOVE_AFTER(&services_listhead, p_prev, p_curr, next);
-            return p_curr;
-        }
+    /* Unknown SIDs may hash to the slot of another service */
+    if (p_service && p_service->p_ldinf->sid == sid) {
+        return p_service;
     }
 
     return NULL;
@@ -148,8 +173,8 @@ int32_t tfm_spm_check_authorization(uint32_t sid,
                                     bool ns_caller)
 {
     struct partition_t *partition = NULL;
-    const uint32_t *dep;
-    int32_t i;
+    const uint32_t *deps_bitmap;
+    uint32_t slot;
 
     SPM_ASSERT(service);
 
@@ -163,14 +188,11 @@ int32_t tfm_spm_check_authorization(uint32_t sid,
             tfm_core_panic();
         }
 
-        dep = LOAD_INFO_DEPS(partition->p_ldinf);
-        for (i = 0; i < partition->p_ldinf->ndeps; i++) {
-            if (dep[i] == sid) {
-                break;
-            }
-        }
-
-        if (i == partition->p_ldinf->ndeps) {
+        /* Dependencies are a bitmap indexed by the SID hash slot */
+        deps_bitmap = LOAD_INFO_DEPS_BITMAP(partition->p_ldinf);
+        slot = SPM_SID_HASH(sid);
+        if (!deps_bitmap ||
+            !(deps_bitmap[slot / 32] & (1UL << (slot % 32)))) {
             return SPM_ERROR_GENERIC;
         }
     }
@@ -310,6 +332,17 @@ void spm_init_connection(struct connection_t *p_connection,
     p_connection->msg.handle = connection_to_handle(p_connection);
 
     p_connection->status = TFM_HANDLE_STATUS_IDLE;
+#if CONFIG_TFM_SPM_BACKEND_IPC == 1
+    p_connection->p_batch_next = NULL;
+    p_connection->p_batch_status = NULL;
+    p_connection->prio_inherited = false;
+#endif
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+    p_connection->is_async = false;
+#endif
+#if CONFIG_TFM_SFN_DIRECT_CALL == 1
+    p_connection->is_direct = false;
+#endif
 #if PSA_FRAMEWORK_HAS_MM_IOVEC
     p_connection->iovec_status = 0;
 #endif
@@ -372,10 +405,11 @@ uint32_t tfm_spm_init(void)
     uint32_t service_setting;
     fih_int fih_rc = FIH_FAILURE;
 
+    BOOT_TIMELINE_CHECKPOINT(BTL_STAGE_SPM, BTL_CP_SPM_INIT, 0);
+
     spm_init_connection_space();
 
     UNI_LISI_INIT_NODE(PARTITION_LIST_ADDR, next);
-    UNI_LISI_INIT_NODE(&services_listhead, next);
 
     /* Init the nonsecure context. */
     tfm_nspm_ctx_init();
@@ -388,7 +422,7 @@ uint32_t tfm_spm_init(void)
 
         service_setting = load_services_assuredly(
                                 partition,
-                                &services_listhead,
+                                sid_hash_tbl,
                                 stateless_services_ref_tbl,
                                 sizeof(stateless_services_ref_tbl));
 
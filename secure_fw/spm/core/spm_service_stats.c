@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "critical_section.h"
+#include "lists.h"
+#include "spm.h"
+#include "spm_service_stats.h"
+#include "spm_timestamp.h"
+#include "tfm_diag_defs.h"
+#include "tfm_hal_isolation.h"
+#include "utilities.h"
+#include "ffm/backend.h"
+#include "load/partition_defs.h"
+#include "load/service_defs.h"
+
+void spm_service_stats_init(void)
+{
+    spm_timestamp_init();
+}
+
+void spm_stats_msg_queued(struct connection_t *p_connection)
+{
+    p_connection->ts_queued = spm_timestamp();
+    p_connection->ts_started = p_connection->ts_queued;
+}
+
+void spm_stats_msg_started(struct connection_t *p_connection)
+{
+    struct tfm_diag_service_stats_t *p_stats = &p_connection->service->stats;
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+    uint32_t queued;
+
+    p_connection->ts_started = spm_timestamp();
+    queued = p_connection->ts_started - p_connection->ts_queued;
+
+    CRITICAL_SECTION_ENTER(cs);
+    p_stats->queue_cycles_total += queued;
+    if (queued > p_stats->queue_cycles_max) {
+        p_stats->queue_cycles_max = queued;
+    }
+    CRITICAL_SECTION_LEAVE(cs);
+}
+
+void spm_stats_msg_replied(struct connection_t *p_connection)
+{
+    struct tfm_diag_service_stats_t *p_stats = &p_connection->service->stats;
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+    uint32_t served = spm_timestamp() - p_connection->ts_started;
+
+    CRITICAL_SECTION_ENTER(cs);
+    p_stats->calls++;
+    p_stats->service_cycles_total += served;
+    if (served > p_stats->service_cycles_max) {
+        p_stats->service_cycles_max = served;
+    }
+    CRITICAL_SECTION_LEAVE(cs);
+}
+
+void spm_stats_bytes_read(struct connection_t *p_connection, size_t bytes)
+{
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+
+    CRITICAL_SECTION_ENTER(cs);
+    p_connection->service->stats.bytes_read += bytes;
+    CRITICAL_SECTION_LEAVE(cs);
+}
+
+void spm_stats_bytes_written(struct connection_t *p_connection, size_t bytes)
+{
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+
+    CRITICAL_SECTION_ENTER(cs);
+    p_connection->service->stats.bytes_written += bytes;
+    CRITICAL_SECTION_LEAVE(cs);
+}
+
+static psa_status_t get_service_stats(uint32_t index,
+                                      struct tfm_diag_service_stats_t *p_stats)
+{
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+    struct partition_t *p_part;
+    struct service_t *p_service;
+
+    UNI_LIST_FOREACH(p_part, PARTITION_LIST_ADDR, next) {
+        if (index >= p_part->p_ldinf->nservices) {
+            index -= p_part->p_ldinf->nservices;
+            continue;
+        }
+
+        p_service = &p_part->p_services[index];
+
+        CRITICAL_SECTION_ENTER(cs);
+        spm_memcpy(p_stats, &p_service->stats, sizeof(*p_stats));
+        CRITICAL_SECTION_LEAVE(cs);
+        p_stats->sid = p_service->p_ldinf->sid;
+
+        return PSA_SUCCESS;
+    }
+
+    return PSA_ERROR_DOES_NOT_EXIST;
+}
+
+void tfm_spm_get_service_stats_handler(uint32_t args[])
+{
+    uint32_t index = args[0];
+    struct tfm_diag_service_stats_t *p_stats =
+                                (struct tfm_diag_service_stats_t *)args[1];
+    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
+    fih_int fih_rc = FIH_FAILURE;
+
+    FIH_CALL(tfm_hal_memory_check, fih_rc,
+             curr_partition->boundary, (uintptr_t)p_stats,
+             sizeof(*p_stats), TFM_HAL_ACCESS_READWRITE);
+    if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+        args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
+        return;
+    }
+
+    args[0] = (uint32_t)get_service_stats(index, p_stats);
+}
+
+void tfm_spm_reset_service_stats_handler(uint32_t args[])
+{
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+    struct partition_t *p_part;
+    uint32_t i;
+
+    UNI_LIST_FOREACH(p_part, PARTITION_LIST_ADDR, next) {
+        for (i = 0; i < p_part->p_ldinf->nservices; i++) {
+            CRITICAL_SECTION_ENTER(cs);
+            spm_memset(&p_part->p_services[i].stats, 0,
+                       sizeof(struct tfm_diag_service_stats_t));
+            CRITICAL_SECTION_LEAVE(cs);
+        }
+    }
+
+    args[0] = (uint32_t)PSA_SUCCESS;
+}
+
+void tfm_spm_get_conn_pool_stats_handler(uint32_t args[])
+{
+    struct tfm_diag_conn_pool_stats_t *p_stats =
+                                (struct tfm_diag_conn_pool_stats_t *)args[0];
+    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
+    fih_int fih_rc = FIH_FAILURE;
+
+    FIH_CALL(tfm_hal_memory_check, fih_rc,
+             curr_partition->boundary, (uintptr_t)p_stats,
+             sizeof(*p_stats), TFM_HAL_ACCESS_READWRITE);
+    if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+        args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
+        return;
+    }
+
+#ifdef CONFIG_TFM_CONNECTION_POOL_ENABLE
+    spm_get_connection_pool_stats(p_stats);
+    args[0] = (uint32_t)PSA_SUCCESS;
+#else
+    args[0] = (uint32_t)PSA_ERROR_NOT_SUPPORTED;
+#endif
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __SPM_SERVICE_STATS_H__
+#define __SPM_SERVICE_STATS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "spm.h"
+
+#ifdef CONFIG_TFM_SPM_SERVICE_STATS
+void spm_service_stats_init(void);
+void spm_stats_msg_queued(struct connection_t *p_connection);
+void spm_stats_msg_started(struct connection_t *p_connection);
+void spm_stats_msg_replied(struct connection_t *p_connection);
+void spm_stats_bytes_read(struct connection_t *p_connection, size_t bytes);
+void spm_stats_bytes_written(struct connection_t *p_connection, size_t bytes);
+
+/**
+ * \brief Get a snapshot of the statistics of one RoT Service.
+ *
+ * \param[in] args  Pointer to stack frame, which carries input parameters.
+ */
+void tfm_spm_get_service_stats_handler(uint32_t args[]);
+
+/**
+ * \brief Clear the statistics of all RoT Services.
+ *
+ * \param[in] args  Pointer to stack frame, which carries input parameters.
+ */
+void tfm_spm_reset_service_stats_handler(uint32_t args[]);
+
+/**
+ * \brief Get a snapshot of the connection pool statistics.
+ *
+ * \param[in] args  Pointer to stack frame, which carries input parameters.
+ */
+void tfm_spm_get_conn_pool_stats_handler(uint32_t args[]);
+#else
+#define spm_service_stats_init()
+#define spm_stats_msg_queued(p_connection)
+#define spm_stats_msg_started(p_connection)
+#define spm_stats_msg_replied(p_connection)
+#define spm_stats_bytes_read(p_connection, bytes)
+#define spm_stats_bytes_written(p_connection, bytes)
+#endif
+
+#endif /* __SPM_SERVICE_STATS_H__ */
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __SPM_TIMESTAMP_H__
+#define __SPM_TIMESTAMP_H__
+
+#include <stdint.h>
+#include "cmsis.h"
+
+/* Timestamps are core cycles if the core has the DWT cycle counter. */
+#ifdef DWT_CTRL_CYCCNTENA_Msk
+#define SPM_TIMESTAMP_IS_CYCLES     1
+#else
+#define SPM_TIMESTAMP_IS_CYCLES     0
+#endif
+
+/*
+ * Start the cycle counter. It does not run in Secure state if Secure
+ * non-invasive debug is not allowed, the timestamps then stay constant.
+ * The boot timeline needs the counter running since the first boot stage,
+ * it is not reset then.
+ */
+static inline void spm_timestamp_init(void)
+{
+#if SPM_TIMESTAMP_IS_CYCLES
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#ifndef CONFIG_TFM_BOOT_TIMELINE
+    DWT->CYCCNT = 0;
+#endif
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+/* Current timestamp, always 0 without a cycle counter. */
+static inline uint32_t spm_timestamp(void)
+{
+#if SPM_TIMESTAMP_IS_CYCLES
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+#endif /* __SPM_TIMESTAMP_H__ */
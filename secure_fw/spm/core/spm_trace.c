@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "critical_section.h"
+#include "spm_timestamp.h"
+#include "spm_trace.h"
+
+#if (CONFIG_TFM_SPM_TRACE_RECORD_NUM & (CONFIG_TFM_SPM_TRACE_RECORD_NUM - 1))
+#error "CONFIG_TFM_SPM_TRACE_RECORD_NUM must be a power of two!"
+#endif
+
+/* Global for debuggers to locate the buffer by symbol */
+struct spm_trace_buffer_t spm_trace_buffer;
+
+static uint32_t trace_timestamp(void)
+{
+#if SPM_TIMESTAMP_IS_CYCLES
+    return spm_timestamp();
+#else
+    /* No cycle counter, the records keep their order by the sequence */
+    return spm_trace_buffer.head;
+#endif
+}
+
+void spm_trace_init(void)
+{
+    spm_timestamp_init();
+
+    spm_trace_buffer.magic = SPM_TRACE_MAGIC;
+    spm_trace_buffer.version = SPM_TRACE_VERSION;
+    spm_trace_buffer.record_size = sizeof(struct spm_trace_record_t);
+    spm_trace_buffer.capacity = CONFIG_TFM_SPM_TRACE_RECORD_NUM;
+    spm_trace_buffer.ts_is_cycles = SPM_TIMESTAMP_IS_CYCLES;
+    spm_trace_buffer.head = 0;
+}
+
+void spm_trace_event(uint8_t event, uint32_t pid, uint32_t arg)
+{
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+    struct spm_trace_record_t *p_rec;
+
+    CRITICAL_SECTION_ENTER(cs);
+    p_rec = &spm_trace_buffer.records[spm_trace_buffer.head &
+                                      (CONFIG_TFM_SPM_TRACE_RECORD_NUM - 1)];
+    p_rec->timestamp = trace_timestamp();
+    p_rec->event = event;
+    p_rec->reserved = 0;
+    p_rec->pid = (uint16_t)pid;
+    p_rec->arg = arg;
+    spm_trace_buffer.head++;
+    CRITICAL_SECTION_LEAVE(cs);
+}
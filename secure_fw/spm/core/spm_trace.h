@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __SPM_TRACE_H__
+#define __SPM_TRACE_H__
+
+#include <stdint.h>
+
+/*
+ * SPM trace events. The values are part of the dump format decoded by
+ * tools/spm_trace_decode.py, keep them in sync.
+ */
+#define SPM_TRACE_EVT_CALL_ENTER    1   /* pid: client,  arg: SID           */
+#define SPM_TRACE_EVT_CALL_EXIT     2   /* pid: client,  arg: reply value   */
+#define SPM_TRACE_EVT_MESSAGING     3   /* pid: service, arg: SID           */
+#define SPM_TRACE_EVT_REPLYING      4   /* pid: service, arg: SID           */
+#define SPM_TRACE_EVT_SCHEDULE      5   /* pid: next,    arg: previous pid  */
+#define SPM_TRACE_EVT_BOUNDARY      6   /* pid: next,    arg: boundary      */
+#define SPM_TRACE_EVT_IRQ           7   /* pid: owner,   arg: IRQ source    */
+#define SPM_TRACE_EVT_MAILBOX       8   /* pid: agent,   arg: SID           */
+#define SPM_TRACE_EVT_FLIH          9   /* pid: owner,   arg: FLIH function */
+#define SPM_TRACE_EVT_WAKEUP        10  /* pid: woken,   arg: signals       */
+#define SPM_TRACE_EVT_START         11  /* pid: started, arg: start flags   */
+
+/* Flags of SPM_TRACE_EVT_START */
+#define SPM_TRACE_START_LAZY        (1U << 0)   /* Started on first signal  */
+#define SPM_TRACE_START_NS_AGENT    (1U << 1)   /* NS Agent                 */
+
+/* Number of records in the ring buffer, must be a power of two */
+#ifndef CONFIG_TFM_SPM_TRACE_RECORD_NUM
+#define CONFIG_TFM_SPM_TRACE_RECORD_NUM     256
+#endif
+
+#define SPM_TRACE_MAGIC             0x54505346  /* "FSPT" */
+#define SPM_TRACE_VERSION           1
+
+/* One trace record, 12 bytes. */
+struct spm_trace_record_t {
+    uint32_t timestamp;             /* Cycle counter, or sequence number    */
+    uint8_t  event;                 /* SPM_TRACE_EVT_*                      */
+    uint8_t  reserved;
+    uint16_t pid;                   /* Partition ID                         */
+    uint32_t arg;                   /* Event argument                       */
+};
+
+/*
+ * The ring buffer. It has no runtime reader, a debugger dumps it through the
+ * 'spm_trace_buffer' symbol. 'head' counts all the records written, the
+ * latest one is at index ((head - 1) % capacity).
+ */
+struct spm_trace_buffer_t {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t capacity;
+    uint32_t ts_is_cycles;          /* 0 if timestamps are sequence numbers */
+    volatile uint32_t head;
+    struct spm_trace_record_t records[CONFIG_TFM_SPM_TRACE_RECORD_NUM];
+};
+
+#ifdef CONFIG_TFM_SPM_TRACE
+
+/* Start the timestamp source and reset the buffer. */
+void spm_trace_init(void);
+
+/* Record one event. Can be called from both Thread and Handler modes. */
+void spm_trace_event(uint8_t event, uint32_t pid, uint32_t arg);
+
+#define SPM_TRACE_INIT()                spm_trace_init()
+#define SPM_TRACE(event, pid, arg)      spm_trace_event((event), \
+                                                        (uint32_t)(pid), \
+                                                        (uint32_t)(arg))
+#else
+#define SPM_TRACE_INIT()
+#define SPM_TRACE(event, pid, arg)
+#endif
+
+#endif /* __SPM_TRACE_H__ */
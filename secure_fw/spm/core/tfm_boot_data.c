@@ -5,6 +5,7 @@
  *
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include "array.h"
@@ -96,6 +97,13 @@ static int32_t tfm_core_check_boot_data_access_policy(uint8_t major_type)
     int32_t rc = -1;
     const uint32_t array_size = ARRAY_SIZE(access_policy_table);
 
+#ifdef CONFIG_TFM_BOOT_TIMELINE
+    /* The boot timeline is not sensitive, every partition may read it */
+    if (major_type == TLV_MAJOR_BTL) {
+        return 0;
+    }
+#endif
+
     partition_id = tfm_spm_partition_get_running_partition_id();
 
     /*
@@ -125,6 +133,207 @@ static int32_t tfm_core_check_boot_data_access_policy(uint8_t major_type)
 #error "Shared data area and non-secure data area is overlapping"
 #endif
 
+#ifdef BOOT_DATA_AVAILABLE
+#if (CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM < 1) || \
+    (CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM > 255)
+#error "CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM must be in range 1..255"
+#endif
+
+/* Number of major types */
+#define BOOT_DATA_MAJOR_NUM     (MAJOR_MASK + 1)
+
+/* Slots of the TLV type hash, a power of two of at least twice the entries */
+#if CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM <= 16
+#define BOOT_DATA_HASH_SIZE     32
+#elif CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM <= 32
+#define BOOT_DATA_HASH_SIZE     64
+#elif CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM <= 64
+#define BOOT_DATA_HASH_SIZE     128
+#elif CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM <= 128
+#define BOOT_DATA_HASH_SIZE     256
+#else
+#define BOOT_DATA_HASH_SIZE     512
+#endif
+
+/* Fold the major type and the upper minor bits into the slot */
+#define BOOT_DATA_HASH(tlv_type) \
+        (((tlv_type) ^ ((tlv_type) >> MODULE_POS)) & (BOOT_DATA_HASH_SIZE - 1))
+
+/*!
+ * \struct boot_data_index_entry_t
+ *
+ * \brief Location of one TLV in the shared data area.
+ */
+struct boot_data_index_entry_t {
+    uint16_t tlv_type;
+    uint16_t offset;        /* Of the TLV entry header, from the area base */
+};
+
+/*!
+ * \var boot_data_index
+ *
+ * \brief Index of the TLVs in the shared data area, grouped by major type.
+ *        The TLVs of major type 'm' are at [major_start[m], major_start[m + 1])
+ *        in the order of the shared data area. 'type_hash' maps a TLV type to
+ *        its position in the index plus one, 0 marks a free slot.
+ */
+static struct boot_data_index_entry_t
+                            boot_data_index[CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM];
+static uint8_t major_start[BOOT_DATA_MAJOR_NUM + 1];
+static uint8_t type_hash[BOOT_DATA_HASH_SIZE];
+
+/* The TLV section length the index was built for, and whether it is usable */
+static uint16_t indexed_len;
+static bool is_index_valid;
+
+/*
+ * Build the index of the TLV section. The index is left invalid if the
+ * section holds more TLVs than the index or is malformed, the callers then
+ * fall back to scanning the section.
+ */
+static void boot_data_index_build(const struct tfm_boot_data *boot_data)
+{
+    struct shared_data_tlv_entry tlv_entry;
+    uint8_t major_fill[BOOT_DATA_MAJOR_NUM];
+    uint32_t num = 0, major, pos, slot;
+    uintptr_t offset;
+
+    is_index_valid = false;
+    indexed_len = boot_data->header.tlv_tot_len;
+    if (indexed_len > BOOT_TFM_SHARED_DATA_SIZE) {
+        return;
+    }
+
+    /* Count the TLVs of each major type */
+    spm_memset(major_fill, 0, sizeof(major_fill));
+    for (offset = SHARED_DATA_HEADER_SIZE; offset < indexed_len;
+         offset += SHARED_DATA_ENTRY_SIZE(tlv_entry.tlv_len)) {
+        if (offset + SHARED_DATA_ENTRY_HEADER_SIZE > indexed_len) {
+            return;
+        }
+        /* Create local copy to avoid unaligned access */
+        (void)spm_memcpy(&tlv_entry,
+                         (const void *)(BOOT_TFM_SHARED_DATA_BASE + offset),
+                         SHARED_DATA_ENTRY_HEADER_SIZE);
+        if ((offset + SHARED_DATA_ENTRY_SIZE(tlv_entry.tlv_len) > indexed_len) ||
+            (++num > CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM)) {
+            return;
+        }
+        major_fill[GET_MAJOR(tlv_entry.tlv_type)]++;
+    }
+
+    major_start[0] = 0;
+    for (major = 0; major < BOOT_DATA_MAJOR_NUM; major++) {
+        major_start[major + 1] = major_start[major] + major_fill[major];
+        major_fill[major] = major_start[major];
+    }
+
+    /* Place the TLVs, the first one wins in the hash if a type repeats */
+    spm_memset(type_hash, 0, sizeof(type_hash));
+    for (offset = SHARED_DATA_HEADER_SIZE; offset < indexed_len;
+         offset += SHARED_DATA_ENTRY_SIZE(tlv_entry.tlv_len)) {
+        (void)spm_memcpy(&tlv_entry,
+                         (const void *)(BOOT_TFM_SHARED_DATA_BASE + offset),
+                         SHARED_DATA_ENTRY_HEADER_SIZE);
+
+        pos = major_fill[GET_MAJOR(tlv_entry.tlv_type)]++;
+        boot_data_index[pos].tlv_type = tlv_entry.tlv_type;
+        boot_data_index[pos].offset   = (uint16_t)offset;
+
+        slot = BOOT_DATA_HASH(tlv_entry.tlv_type);
+        while ((type_hash[slot] != 0) &&
+               (boot_data_index[type_hash[slot] - 1].tlv_type
+                != tlv_entry.tlv_type)) {
+            slot = (slot + 1) & (BOOT_DATA_HASH_SIZE - 1);
+        }
+        if (type_hash[slot] == 0) {
+            type_hash[slot] = (uint8_t)(pos + 1);
+        }
+    }
+
+    is_index_valid = true;
+}
+
+/*
+ * Returns true if the index covers the current TLV section. Stages which
+ * append TLVs after the SPM started, such as the boot timeline, trigger a
+ * rebuild on the next request.
+ */
+static bool boot_data_index_ready(void)
+{
+    const struct tfm_boot_data *boot_data =
+                            (const struct tfm_boot_data *)BOOT_TFM_SHARED_DATA_BASE;
+
+    if (boot_data->header.tlv_tot_len != indexed_len) {
+        boot_data_index_build(boot_data);
+    }
+
+    return is_index_valid;
+}
+
+/* Returns the address of the TLV entry of 'tlv_type', 0 if not found. */
+static uintptr_t boot_data_find_tlv(uint16_t tlv_type)
+{
+    struct tfm_boot_data *boot_data;
+    struct shared_data_tlv_entry tlv_entry;
+    uintptr_t tlv_end, offset;
+    uint32_t slot;
+
+    if (boot_data_index_ready()) {
+        slot = BOOT_DATA_HASH(tlv_type);
+        while (type_hash[slot] != 0) {
+            if (boot_data_index[type_hash[slot] - 1].tlv_type == tlv_type) {
+                return BOOT_TFM_SHARED_DATA_BASE +
+                       boot_data_index[type_hash[slot] - 1].offset;
+            }
+            slot = (slot + 1) & (BOOT_DATA_HASH_SIZE - 1);
+        }
+        return 0;
+    }
+
+    boot_data = (struct tfm_boot_data *)BOOT_TFM_SHARED_DATA_BASE;
+    tlv_end = BOOT_TFM_SHARED_DATA_BASE + boot_data->header.tlv_tot_len;
+    offset  = BOOT_TFM_SHARED_DATA_BASE + SHARED_DATA_HEADER_SIZE;
+
+    for (; offset < tlv_end; offset += SHARED_DATA_ENTRY_SIZE(tlv_entry.tlv_len)) {
+        (void)spm_memcpy(&tlv_entry, (const void *)offset,
+                         SHARED_DATA_ENTRY_HEADER_SIZE);
+        if (tlv_entry.tlv_type == tlv_type) {
+            return offset;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Append the TLV at 'offset' to the output boot data. Returns false if it
+ * does not fit into the buffer.
+ */
+static bool boot_data_copy_tlv(struct tfm_boot_data *out, uint16_t buf_size,
+                               uintptr_t offset)
+{
+    struct shared_data_tlv_entry tlv_entry;
+    size_t tlv_size;
+
+    /* Create local copy to avoid unaligned access */
+    (void)spm_memcpy(&tlv_entry, (const void *)offset,
+                     SHARED_DATA_ENTRY_HEADER_SIZE);
+    tlv_size = SHARED_DATA_ENTRY_SIZE(tlv_entry.tlv_len);
+
+    /* Check buffer overflow */
+    if ((out->header.tlv_tot_len + tlv_size) > buf_size) {
+        return false;
+    }
+
+    (void)spm_memcpy((uint8_t *)out + out->header.tlv_tot_len,
+                     (const void *)offset, tlv_size);
+    out->header.tlv_tot_len += tlv_size;
+
+    return true;
+}
+#endif /* BOOT_DATA_AVAILABLE */
+
 void tfm_core_validate_boot_data(void)
 {
 #ifdef BOOT_DATA_AVAILABLE
@@ -134,6 +343,7 @@ void tfm_core_validate_boot_data(void)
 
     if (boot_data->header.tlv_magic == SHARED_DATA_TLV_INFO_MAGIC) {
         is_boot_data_valid = BOOT_DATA_VALID;
+        boot_data_index_build(boot_data);
     }
 #else
     is_boot_data_valid = BOOT_DATA_VALID;
@@ -147,10 +357,10 @@ void tfm_core_get_boot_data_handler(uint32_t args[])
     uint16_t buf_size  = (uint16_t)args[2];
     struct tfm_boot_data *boot_data;
 #ifdef BOOT_DATA_AVAILABLE
-    uint8_t *ptr;
+    struct tfm_boot_data *shared_data;
     struct shared_data_tlv_entry tlv_entry;
     uintptr_t tlv_end, offset;
-    size_t next_tlv_offset;
+    uint32_t i;
 #endif /* BOOT_DATA_AVAILABLE */
     struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
     fih_int fih_rc = FIH_FAILURE;
@@ -174,13 +384,6 @@ void tfm_core_get_boot_data_handler(uint32_t args[])
         return;
     }
 
-#ifdef BOOT_DATA_AVAILABLE
-    /* Get the boundaries of TLV section */
-    boot_data = (struct tfm_boot_data *)BOOT_TFM_SHARED_DATA_BASE;
-    tlv_end = BOOT_TFM_SHARED_DATA_BASE + boot_data->header.tlv_tot_len;
-    offset  = BOOT_TFM_SHARED_DATA_BASE + SHARED_DATA_HEADER_SIZE;
-#endif /* BOOT_DATA_AVAILABLE */
-
     /* Add header to output buffer as well */
     if (buf_size < SHARED_DATA_HEADER_SIZE) {
         args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
@@ -192,27 +395,36 @@ void tfm_core_get_boot_data_handler(uint32_t args[])
     }
 
 #ifdef BOOT_DATA_AVAILABLE
-    ptr = boot_data->data;
-    /* Iterates over the TLV section and copy TLVs with requested major
-     * type to the provided buffer.
-     */
-    for (; offset < tlv_end; offset += next_tlv_offset) {
-        /* Create local copy to avoid unaligned access */
-        (void)spm_memcpy(&tlv_entry, (const void *)offset,
-                         SHARED_DATA_ENTRY_HEADER_SIZE);
+    if (boot_data_index_ready() && (tlv_major < BOOT_DATA_MAJOR_NUM)) {
+        /* Copy the TLVs of the requested major type only */
+        for (i = major_start[tlv_major]; i < major_start[tlv_major + 1]; i++) {
+            if (!boot_data_copy_tlv(boot_data, buf_size,
+                                    BOOT_TFM_SHARED_DATA_BASE +
+                                    boot_data_index[i].offset)) {
+                args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
+                return;
+            }
+        }
+    } else {
+        /* Get the boundaries of TLV section */
+        shared_data = (struct tfm_boot_data *)BOOT_TFM_SHARED_DATA_BASE;
+        tlv_end = BOOT_TFM_SHARED_DATA_BASE + shared_data->header.tlv_tot_len;
+        offset  = BOOT_TFM_SHARED_DATA_BASE + SHARED_DATA_HEADER_SIZE;
 
-        next_tlv_offset = SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len;
+        /* Iterates over the TLV section and copy TLVs with requested major
+         * type to the provided buffer.
+         */
+        for (; offset < tlv_end;
+             offset += SHARED_DATA_ENTRY_SIZE(tlv_entry.tlv_len)) {
+            /* Create local copy to avoid unaligned access */
+            (void)spm_memcpy(&tlv_entry, (const void *)offset,
+                             SHARED_DATA_ENTRY_HEADER_SIZE);
 
-        if (GET_MAJOR(tlv_entry.tlv_type) == tlv_major) {
-            /* Check buffer overflow */
-            if (((ptr - buf_start) + next_tlv_offset) > buf_size) {
+            if ((GET_MAJOR(tlv_entry.tlv_type) == tlv_major) &&
+                !boot_data_copy_tlv(boot_data, buf_size, offset)) {
                 args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
                 return;
             }
-
-            (void)spm_memcpy(ptr, (const void *)offset, next_tlv_offset);
-            ptr += next_tlv_offset;
-            boot_data->header.tlv_tot_len += next_tlv_offset;
         }
     }
 #endif /* BOOT_DATA_AVAILABLE */
@@ -220,3 +432,70 @@ void tfm_core_get_boot_data_handler(uint32_t args[])
     args[0] = (uint32_t)PSA_SUCCESS;
     return;
 }
+
+void tfm_core_get_boot_data_tlv_handler(uint32_t args[])
+{
+    uint16_t  tlv_type = (uint16_t)args[0];
+    uint8_t  *buf      = (uint8_t *)args[1];
+    uint32_t  buf_size = args[2];
+    uint32_t *p_len    = (uint32_t *)args[3];
+#ifdef BOOT_DATA_AVAILABLE
+    struct shared_data_tlv_entry tlv_entry;
+    uintptr_t offset;
+#endif /* BOOT_DATA_AVAILABLE */
+    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
+    fih_int fih_rc = FIH_FAILURE;
+
+    FIH_CALL(tfm_hal_memory_check, fih_rc,
+             curr_partition->boundary, (uintptr_t)buf,
+             buf_size, TFM_HAL_ACCESS_READWRITE);
+    if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+        args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
+        return;
+    }
+
+    FIH_CALL(tfm_hal_memory_check, fih_rc,
+             curr_partition->boundary, (uintptr_t)p_len,
+             sizeof(*p_len), TFM_HAL_ACCESS_READWRITE);
+    if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+        args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
+        return;
+    }
+
+    if (is_boot_data_valid != BOOT_DATA_VALID) {
+        args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
+        return;
+    }
+
+    /* Check whether caller has access right to the major type of the TLV */
+    if (tfm_core_check_boot_data_access_policy(GET_MAJOR(tlv_type))) {
+        args[0] = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
+        return;
+    }
+
+#ifdef BOOT_DATA_AVAILABLE
+    offset = boot_data_find_tlv(tlv_type);
+    if (offset == 0) {
+        args[0] = (uint32_t)PSA_ERROR_DOES_NOT_EXIST;
+        return;
+    }
+
+    /* Create local copy to avoid unaligned access */
+    (void)spm_memcpy(&tlv_entry, (const void *)offset,
+                     SHARED_DATA_ENTRY_HEADER_SIZE);
+
+    /* Report the length even if the buffer is too small, to size it */
+    *p_len = tlv_entry.tlv_len;
+    if (tlv_entry.tlv_len > buf_size) {
+        args[0] = (uint32_t)PSA_ERROR_BUFFER_TOO_SMALL;
+        return;
+    }
+
+    (void)spm_memcpy(buf, (const void *)(offset + SHARED_DATA_ENTRY_HEADER_SIZE),
+                     tlv_entry.tlv_len);
+
+    args[0] = (uint32_t)PSA_SUCCESS;
+#else
+    args[0] = (uint32_t)PSA_ERROR_DOES_NOT_EXIST;
+#endif /* BOOT_DATA_AVAILABLE */
+}
@@ -18,6 +18,14 @@
  */
 void tfm_core_get_boot_data_handler(uint32_t args[]);
 
+/**
+ * \brief Retrieve the value of a single TLV, looked up by its type, from the
+ *        shared memory area between bootloader and runtime firmware.
+ *
+ * \param[in] args  Pointer to stack frame, which carries input parameters.
+ */
+void tfm_core_get_boot_data_tlv_handler(uint32_t args[]);
+
 /**
  * \brief Validate the content of shared memory area, which stores the shared
  *        data between bootloader and runtime firmware.
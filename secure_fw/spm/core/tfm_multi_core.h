@@ -9,6 +9,8 @@
 #define __TFM_MULTI_CORE_H__
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /* Follow CMSE flag definitions */
 #define MEM_CHECK_MPU_READWRITE         (1 << 0x0)
@@ -36,6 +38,14 @@ struct mem_attr_info_t {
     bool is_unpriv_wr_allow;   /* Unprivileged write is allowed or not */
 };
 
+/* A memory region and its attributes in memory access check. */
+struct mem_region_attr_t {
+    uintptr_t              base;        /* Start address of the region */
+    uintptr_t              limit;       /* Address of the last byte */
+    bool                   is_secure;   /* Secure memory or non-secure memory */
+    struct mem_attr_info_t attr;        /* Memory access attributes */
+};
+
 /**
  * \brief Retrieve general security isolation configuration information of the
  *        target memory region according to the system memory region layout and
@@ -86,6 +96,17 @@ void tfm_get_secure_mem_region_attr(const void *p, size_t s,
 void tfm_get_ns_mem_region_attr(const void *p, size_t s,
                                 struct mem_attr_info_t *p_attr);
 
+/**
+ * \brief Build the memory region tables used by the memory checks, and check
+ *        that the memory layout has no overlapping regions.
+ *
+ * \note  The checks of all the memory ranges fail if the layout is invalid.
+ *
+ * \return SPM_SUCCESS if the memory layout is valid,
+ *         SPM_ERROR_GENERIC otherwise.
+ */
+int32_t tfm_mem_region_init(void);
+
 /**
  * \brief Check whether a memory access is allowed to access to a memory range
  *
@@ -99,6 +120,24 @@ void tfm_get_ns_mem_region_attr(const void *p, size_t s,
  */
 int32_t tfm_has_access_to_region(const void *p, size_t s, uint32_t flags);
 
+/**
+ * \brief Validate a non-secure memory region shared with NSPE once, and keep
+ *        it. Later checks of ranges inside the region pass without looking up
+ *        the memory attributes again.
+ *
+ * \note  Only called at initialization, as the non-secure memory layout is
+ *        static.
+ *
+ * \param[in] p               The start address of the region
+ * \param[in] s               The size of the region
+ * \param[in] flags           The memory access types allowed in the region.
+ *                            They must include MEM_CHECK_NONSECURE.
+ *
+ * \return SPM_SUCCESS if the region is accessible and kept,
+ *         SPM_ERROR_GENERIC otherwise.
+ */
+int32_t tfm_register_ns_shared_region(const void *p, size_t s, uint32_t flags);
+
 /**
  * \brief Initialization of the multi core communication.
  *
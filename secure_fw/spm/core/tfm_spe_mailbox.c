@@ -14,6 +14,9 @@
 
 #include "async.h"
 #include "config_impl.h"
+#include "config_spm.h"
+#include "critical_section.h"
+#include "internal_status_code.h"
 #include "psa/error.h"
 #include "utilities.h"
 #include "tfm_arch.h"
@@ -25,8 +28,18 @@
 #include "ffm/agent_api.h"
 
 
+#if (CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM < 1) || \
+    (CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM > NUM_MAILBOX_QUEUE_SLOT)
+#error "CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM must be in range 1..NUM_MAILBOX_QUEUE_SLOT"
+#endif
+
 static struct secure_mailbox_queue_t spe_mailbox_queue;
 
+#if CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM > 1
+/* The number of replies which NSPE is not notified of yet */
+static uint32_t reply_notify_pend_num;
+#endif
+
 /*
  * Local copies of invecs and outvecs associated with each mailbox message
  * while it is being processed.
@@ -35,12 +48,58 @@ struct vectors {
     psa_invec in_vec[PSA_MAX_IOVEC];
     psa_outvec out_vec[PSA_MAX_IOVEC];
     psa_outvec *original_out_vec;
+#if NUM_MAILBOX_SHM_BUF > 0
+    struct mailbox_shm_vec_t *original_shm_out_vec;
+#endif
     size_t out_len;
     bool in_use;
 };
 static struct vectors vectors[NUM_MAILBOX_QUEUE_SLOT] = {0};
 
 
+#ifdef MAILBOX_RING_TRANSPORT
+__STATIC_INLINE void set_spe_queue_empty_status(uint8_t idx)
+{
+    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+        spe_mailbox_queue.is_empty[idx] = true;
+    }
+}
+
+__STATIC_INLINE void clear_spe_queue_empty_status(uint8_t idx)
+{
+    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+        spe_mailbox_queue.is_empty[idx] = false;
+    }
+}
+
+__STATIC_INLINE bool get_spe_queue_empty_status(uint8_t idx)
+{
+    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+        return spe_mailbox_queue.is_empty[idx];
+    }
+
+    return false;
+}
+
+/*
+ * Put the replied NSPE slot into the replied ring. The SPE mailbox replies
+ * from both the mailbox handling and the asynchronous reply from SPM, so the
+ * single producer is kept by a local critical section.
+ * Returns true if NSPE should be notified.
+ */
+static bool set_nspe_queue_replied_ring(struct ns_mailbox_queue_t *ns_queue,
+                                        uint8_t ns_slot_idx)
+{
+    struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
+    bool need_notify;
+
+    CRITICAL_SECTION_ENTER(cs_assert);
+    need_notify = mailbox_ring_put(&ns_queue->replied_ring, ns_slot_idx);
+    CRITICAL_SECTION_LEAVE(cs_assert);
+
+    return need_notify;
+}
+#else /* MAILBOX_RING_TRANSPORT */
 __STATIC_INLINE void set_spe_queue_empty_status(uint8_t idx)
 {
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
@@ -84,6 +143,7 @@ __STATIC_INLINE void clear_nspe_queue_pend_status(
 {
     ns_queue->pend_slots &= ~mask;
 }
+#endif /* MAILBOX_RING_TRANSPORT */
 
 __STATIC_INLINE int32_t get_spe_mailbox_msg_handle(uint8_t idx,
                                                    mailbox_msg_handle_t *handle)
@@ -133,6 +193,36 @@ __STATIC_INLINE struct mailbox_reply_t *get_nspe_reply_addr(uint8_t idx)
     return &spe_mailbox_queue.ns_queue->queue[ns_slot_idx].reply;
 }
 
+#if NUM_MAILBOX_SHM_BUF > 0
+/*
+ * The descriptor arrays are read from, and the output lengths written back to,
+ * non-secure memory. They must lie in one registered buffer which allows the
+ * access, as the payloads do.
+ */
+static bool mailbox_shm_array_valid(const void *ptr, size_t size,
+                                    uint32_t access)
+{
+    const struct mailbox_shm_buf_t *buf;
+    uintptr_t base = (uintptr_t)ptr;
+    uint32_t idx;
+
+    if (size == 0) {
+        return true;
+    }
+
+    for (idx = 0; idx < spe_mailbox_queue.nr_shm_buf; idx++) {
+        buf = &spe_mailbox_queue.shm_buf[idx];
+        if ((buf->access & access) && (base >= (uintptr_t)buf->base) &&
+            (base - (uintptr_t)buf->base <= buf->size) &&
+            (size <= buf->size - (base - (uintptr_t)buf->base))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
+
 static void mailbox_direct_reply(uint8_t idx, uint32_t result)
 {
     struct mailbox_reply_t *reply_ptr;
@@ -141,6 +231,18 @@ static void mailbox_direct_reply(uint8_t idx, uint32_t result)
     /* Copy outvec lengths back if necessary */
     if (vectors[idx].in_use) {
         for (int i = 0; i < vectors[idx].out_len; i++) {
+#if NUM_MAILBOX_SHM_BUF > 0
+            if (vectors[idx].original_shm_out_vec) {
+                if (mailbox_shm_array_valid(
+                                &vectors[idx].original_shm_out_vec[i],
+                                sizeof(struct mailbox_shm_vec_t),
+                                MAILBOX_SHM_BUF_WRITE)) {
+                    vectors[idx].original_shm_out_vec[i].len =
+                                                vectors[idx].out_vec[i].len;
+                }
+                continue;
+            }
+#endif
             vectors[idx].original_out_vec[i].len = vectors[idx].out_vec[i].len;
         }
         vectors[idx].in_use = false;
@@ -159,6 +261,58 @@ static void mailbox_direct_reply(uint8_t idx, uint32_t result)
      */
 }
 
+/*
+ * Notify NSPE of the replies, unless the notification is not needed as NSPE
+ * is still handling earlier replies.
+ * With reply coalescing, the notification is delayed until
+ * CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM replies are pending or the deadline
+ * expires, unless one of the replies is urgent.
+ */
+static void mailbox_notify_reply(uint32_t nr_replies, bool need_notify,
+                                 bool is_urgent)
+{
+#if CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM > 1
+    struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
+    bool start_timer = false;
+
+    CRITICAL_SECTION_ENTER(cs_assert);
+
+    /* Replies behind a pending notification are counted in */
+    if (!need_notify && (reply_notify_pend_num == 0)) {
+        CRITICAL_SECTION_LEAVE(cs_assert);
+        return;
+    }
+
+    if (reply_notify_pend_num == 0) {
+        start_timer = true;
+    }
+    reply_notify_pend_num += nr_replies;
+
+    if (is_urgent ||
+        (reply_notify_pend_num >= CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM)) {
+        reply_notify_pend_num = 0;
+        need_notify = true;
+        start_timer = false;
+    } else {
+        need_notify = false;
+    }
+
+    CRITICAL_SECTION_LEAVE(cs_assert);
+
+    if (start_timer) {
+        tfm_mailbox_hal_start_reply_timer(CONFIG_TFM_MAILBOX_REPLY_TIMEOUT_US);
+    }
+#else
+    (void)nr_replies;
+    (void)is_urgent;
+#endif /* CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM > 1 */
+
+    if (need_notify) {
+        MAILBOX_STATS_ADD(spe_mailbox_queue.ns_queue, nr_reply_notify, 1);
+        tfm_mailbox_hal_notify_peer();
+    }
+}
+
 __STATIC_INLINE int32_t check_mailbox_msg(const struct mailbox_msg_t *msg)
 {
     /*
@@ -169,13 +323,147 @@ __STATIC_INLINE int32_t check_mailbox_msg(const struct mailbox_msg_t *msg)
     return MAILBOX_SUCCESS;
 }
 
+#if NUM_MAILBOX_SHM_BUF > 0
+/*
+ * Get the address of a vector in a shared payload buffer. The buffer is
+ * validated at initialization, so only the bounds are checked here.
+ */
+static bool mailbox_get_shm_vec_addr(const struct mailbox_shm_vec_t *vec,
+                                     uint32_t access, void **addr)
+{
+    const struct mailbox_shm_buf_t *buf;
+
+    if (vec->len == 0) {
+        *addr = NULL;
+        return true;
+    }
+
+    if (vec->buf_idx >= spe_mailbox_queue.nr_shm_buf) {
+        return false;
+    }
+
+    buf = &spe_mailbox_queue.shm_buf[vec->buf_idx];
+    if (!(buf->access & access)) {
+        return false;
+    }
+
+    if ((vec->offset > buf->size) || (vec->len > buf->size - vec->offset)) {
+        return false;
+    }
+
+    *addr = (uint8_t *)buf->base + vec->offset;
+
+    return true;
+}
+
+/* Deliver a psa_call() with the vectors in the shared payload buffers */
+static psa_status_t mailbox_shm_psa_call(const struct mailbox_msg_t *msg_ptr,
+                                         uint8_t idx)
+{
+    const struct psa_client_params_t *params = &msg_ptr->params;
+    struct client_params_t client_params = {0};
+    struct mailbox_shm_vec_t vec;
+    size_t in_len = params->psa_call_shm_params.in_len;
+    size_t out_len = params->psa_call_shm_params.out_len;
+    uint32_t control;
+    void *addr;
+
+    if ((in_len > PSA_MAX_IOVEC) || (out_len > PSA_MAX_IOVEC - in_len)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    if (!mailbox_shm_array_valid(params->psa_call_shm_params.in_vec,
+                                 in_len * sizeof(struct mailbox_shm_vec_t),
+                                 MAILBOX_SHM_BUF_READ) ||
+        !mailbox_shm_array_valid(params->psa_call_shm_params.out_vec,
+                                 out_len * sizeof(struct mailbox_shm_vec_t),
+                                 MAILBOX_SHM_BUF_WRITE)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    spm_memset(&vectors[idx], 0, sizeof(vectors[idx]));
+
+    /* Fetch each descriptor once from non-secure memory */
+    for (int i = 0; i < in_len; i++) {
+        spm_memcpy(&vec, &params->psa_call_shm_params.in_vec[i], sizeof(vec));
+        if (!mailbox_get_shm_vec_addr(&vec, MAILBOX_SHM_BUF_READ, &addr)) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+
+        vectors[idx].in_vec[i].base = addr;
+        vectors[idx].in_vec[i].len = vec.len;
+    }
+
+    for (int i = 0; i < out_len; i++) {
+        spm_memcpy(&vec, &params->psa_call_shm_params.out_vec[i], sizeof(vec));
+        if (!mailbox_get_shm_vec_addr(&vec, MAILBOX_SHM_BUF_WRITE, &addr)) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+
+        vectors[idx].out_vec[i].base = addr;
+        vectors[idx].out_vec[i].len = vec.len;
+    }
+
+    vectors[idx].in_use = true;
+    vectors[idx].out_len = out_len;
+    vectors[idx].original_shm_out_vec = params->psa_call_shm_params.out_vec;
+
+    control = PARAM_PACK(params->psa_call_shm_params.type, in_len, out_len);
+    control = PARAM_SET_NS_INVEC(control);
+    control = PARAM_SET_NS_OUTVEC(control);
+
+    client_params.ns_client_id_stateless = msg_ptr->client_id;
+    client_params.p_invecs = vectors[idx].in_vec;
+    client_params.p_outvecs = vectors[idx].out_vec;
+
+    return tfm_rpc_psa_call(params->psa_call_shm_params.handle, control,
+                            &client_params, NULL);
+}
+
+/*
+ * Keep a copy of the shared payload buffers registered by NSPE and validate
+ * each of them once. An invalid buffer is kept empty, so that the calls
+ * referring to it fail.
+ */
+static void mailbox_shm_buf_init(void)
+{
+    struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
+    struct mailbox_shm_buf_t *buf;
+    uint32_t idx, nr_buf, flags;
+
+    nr_buf = ns_queue->nr_shm_buf;
+    if (nr_buf > NUM_MAILBOX_SHM_BUF) {
+        nr_buf = NUM_MAILBOX_SHM_BUF;
+    }
+
+    for (idx = 0; idx < nr_buf; idx++) {
+        buf = &spe_mailbox_queue.shm_buf[idx];
+        spm_memcpy(buf, &ns_queue->shm_buf[idx], sizeof(*buf));
+
+        if (buf->access & MAILBOX_SHM_BUF_WRITE) {
+            flags = MEM_CHECK_NONSECURE | MEM_CHECK_MPU_READWRITE;
+        } else {
+            flags = MEM_CHECK_NONSECURE | MEM_CHECK_MPU_READ;
+        }
+
+        if (tfm_register_ns_shared_region(buf->base, buf->size, flags) !=
+            SPM_SUCCESS) {
+            buf->size = 0;
+            buf->access = 0;
+        }
+    }
+
+    spe_mailbox_queue.nr_shm_buf = nr_buf;
+}
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
+
 /* Passes the request from the mailbox message into SPM.
  * idx indicates the slot used to use for any immediate reply.
- * If it queues the reply immediately, updates reply_slots accordingly.
+ * If it queues the reply immediately, sets is_replied accordingly.
  */
 static int32_t tfm_mailbox_dispatch(const struct mailbox_msg_t *msg_ptr,
                                     uint8_t idx,
-                                    mailbox_queue_status_t *reply_slots)
+                                    bool *is_replied)
 {
     const struct psa_client_params_t *params = &msg_ptr->params;
     struct client_params_t client_params = {0};
@@ -195,7 +483,7 @@ static int32_t tfm_mailbox_dispatch(const struct mailbox_msg_t *msg_ptr,
     SPM_ASSERT(params != NULL);
     SPM_ASSERT(psa_ret != NULL);
 
-    switch (msg_ptr->call_type) {
+    switch (msg_ptr->call_type & MAILBOX_CALL_TYPE_MASK) {
     case MAILBOX_PSA_FRAMEWORK_VERSION:
         psa_ret = tfm_rpc_psa_framework_version();
         sync = true;
@@ -207,11 +495,23 @@ static int32_t tfm_mailbox_dispatch(const struct mailbox_msg_t *msg_ptr,
         break;
 
     case MAILBOX_PSA_CALL:
+#if NUM_MAILBOX_SHM_BUF > 0
+        if (msg_ptr->call_type & MAILBOX_SHM_VEC) {
+            psa_ret = mailbox_shm_psa_call(msg_ptr, idx);
+            if (psa_ret != PSA_SUCCESS) {
+                sync = true;
+            }
+            break;
+        }
+#endif
         /* TODO check vector validity before use */
         /* Make local copy of invecs and outvecs */
         vectors[idx].in_use = true;
         vectors[idx].out_len = params->psa_call_params.out_len;
         vectors[idx].original_out_vec = params->psa_call_params.out_vec;
+#if NUM_MAILBOX_SHM_BUF > 0
+        vectors[idx].original_shm_out_vec = NULL;
+#endif
         for (int i = 0; i < PSA_MAX_IOVEC; i++) {
             if (i < params->psa_call_params.in_len) {
                 vectors[idx].in_vec[i] = params->psa_call_params.in_vec[i];
@@ -267,19 +567,183 @@ static int32_t tfm_mailbox_dispatch(const struct mailbox_msg_t *msg_ptr,
 
     /* Any synchronous result should be returned immediately */
     if (sync) {
-        *reply_slots |= (1 << idx);
+        *is_replied = true;
         mailbox_direct_reply(idx, (uint32_t)psa_ret);
     }
 
     return MAILBOX_SUCCESS;
 }
 
+/*
+ * Fetch the mailbox message in the NSPE mailbox queue slot and deliver it to
+ * SPM. Returns true if the PSA client call is replied immediately, and sets
+ * is_urgent if the reply is urgent.
+ */
+static bool mailbox_handle_slot(struct ns_mailbox_queue_t *ns_queue,
+                                uint8_t idx, bool *is_urgent)
+{
+    struct mailbox_msg_t *msg_ptr;
+    bool is_replied = false;
+
+    /*
+     * TODO
+     * The operations are simplified here. Use the SPE mailbox queue
+     * slot with the same idx as that of the NSPE mailbox queue slot.
+     * A more general implementation should dynamically search and
+     * select an empty SPE mailbox queue slot.
+     */
+    clear_spe_queue_empty_status(idx);
+    spe_mailbox_queue.queue[idx].ns_slot_idx = idx;
+
+    msg_ptr = &spe_mailbox_queue.queue[idx].msg;
+    spm_memcpy(msg_ptr, &ns_queue->queue[idx].msg, sizeof(*msg_ptr));
+
+    if (check_mailbox_msg(msg_ptr) != MAILBOX_SUCCESS) {
+        mailbox_clean_queue_slot(idx);
+        return false;
+    }
+
+    /* The slot is cleaned once replied, keep the flag */
+    *is_urgent = !!(msg_ptr->call_type & MAILBOX_URGENT_REPLY);
+
+    get_spe_mailbox_msg_handle(idx,
+                               &spe_mailbox_queue.queue[idx].msg_handle);
+
+    /*
+     * Set the current slot index under processing.
+     * The value is used in mailbox_get_caller_data() to identify the
+     * mailbox queue slot.
+     */
+    spe_mailbox_queue.cur_proc_slot_idx = idx;
+
+    if (tfm_mailbox_dispatch(msg_ptr, idx, &is_replied) != MAILBOX_SUCCESS) {
+        mailbox_clean_queue_slot(idx);
+        return false;
+    }
+
+    /* Clean up the current slot index under processing */
+    spe_mailbox_queue.cur_proc_slot_idx = NUM_MAILBOX_QUEUE_SLOT;
+
+    return is_replied;
+}
+
+/*
+ * Get the priority lane of the message in a NSPE mailbox queue slot. The
+ * message is read again when it is handled, the lane only orders the slots.
+ */
+__STATIC_INLINE uint8_t get_nspe_slot_prio_lane(
+                                    const struct ns_mailbox_queue_t *ns_queue,
+                                    uint8_t idx)
+{
+    return mailbox_prio_lane(ns_queue->queue[idx].msg.call_type);
+}
+
+#ifdef MAILBOX_RING_TRANSPORT
+/*
+ * The pending ring indices are in non-secure memory. A ring never holds more
+ * entries than the mailbox queue has slots. Otherwise the indices are corrupt
+ * and the ring is reset to empty.
+ */
+static bool check_nspe_pend_ring(struct mailbox_ring_t *ring)
+{
+    uint32_t head = ring->head;
+
+    if (head - ring->tail <= NUM_MAILBOX_QUEUE_SLOT) {
+        return true;
+    }
+
+    ring->tail = head;
+
+    return false;
+}
+
 int32_t tfm_mailbox_handle_msg(void)
 {
-    uint8_t idx;
+    uint8_t idx, lane;
+    uint8_t pend_idx[NUM_MAILBOX_QUEUE_SLOT];
+    uint8_t pend_lane[NUM_MAILBOX_QUEUE_SLOT];
+    uint32_t i, nr_get, nr_pend = 0, nr_replies = 0;
+    bool is_pend = false, need_notify = false;
+    bool is_urgent, is_any_urgent = false;
+    struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
+
+    SPM_ASSERT(ns_queue != NULL);
+
+    if (!check_nspe_pend_ring(&ns_queue->pend_ring)) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    /*
+     * Drain the pending ring. NSPE only notifies when the ring was drained
+     * before its request, so the requests queued in the meantime are handled
+     * in this round.
+     * Each queued slot stays in use until its reply, so a well-behaved NSPE
+     * cannot queue more than NUM_MAILBOX_QUEUE_SLOT entries in a round. The
+     * drain stops there so that NSPE cannot keep SPE in this loop.
+     */
+    for (nr_get = 0; nr_get < NUM_MAILBOX_QUEUE_SLOT; nr_get++) {
+        if (!mailbox_ring_get(&ns_queue->pend_ring, &idx)) {
+            break;
+        }
+
+        is_pend = true;
+
+        /* The ring is in non-secure memory. Skip invalid or busy slots. */
+        if (!get_spe_queue_empty_status(idx)) {
+            continue;
+        }
+
+        /*
+         * Taken, so that a slot is collected only once. The lane is read
+         * once, NSPE may change the slot content meanwhile.
+         */
+        clear_spe_queue_empty_status(idx);
+        pend_lane[nr_pend] = get_nspe_slot_prio_lane(ns_queue, idx);
+        pend_idx[nr_pend++] = idx;
+    }
+
+    /* Check if NSPE mailbox did assert a PSA client call request */
+    if (!is_pend) {
+        return MAILBOX_NO_PEND_EVENT;
+    }
+
+    /* Handle the collected slots from the highest priority lane */
+    for (lane = 0; lane < MAILBOX_PRIO_LANE_NUM; lane++) {
+        for (i = 0; i < nr_pend; i++) {
+            if (pend_lane[i] != lane) {
+                continue;
+            }
+
+            idx = pend_idx[i];
+
+            if (!mailbox_handle_slot(ns_queue, idx, &is_urgent)) {
+                continue;
+            }
+
+            nr_replies++;
+            is_any_urgent |= is_urgent;
+            if (set_nspe_queue_replied_ring(ns_queue, idx)) {
+                need_notify = true;
+            }
+        }
+    }
+
+    /* A single notification for the replies of this round */
+    if (nr_replies) {
+        mailbox_notify_reply(nr_replies, need_notify, is_any_urgent);
+    }
+
+    return MAILBOX_SUCCESS;
+}
+#else /* MAILBOX_RING_TRANSPORT */
+int32_t tfm_mailbox_handle_msg(void)
+{
+    uint8_t idx, lane;
+    uint32_t nr_replies = 0;
     mailbox_queue_status_t mask_bits, pend_slots, reply_slots = 0;
+    mailbox_queue_status_t lane_slots[MAILBOX_PRIO_LANE_NUM] = {0};
+    bool is_urgent, is_any_urgent = false;
     struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
-    struct mailbox_msg_t *msg_ptr;
 
     SPM_ASSERT(ns_queue != NULL);
 
@@ -294,48 +758,28 @@ int32_t tfm_mailbox_handle_msg(void)
         return MAILBOX_NO_PEND_EVENT;
     }
 
+    /* Sort the pending slots into the priority lanes */
     for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
         mask_bits = (1 << idx);
-        /* Check if current NSPE mailbox queue slot is pending for handling */
-        if (!(pend_slots & mask_bits)) {
-            continue;
+        if (pend_slots & mask_bits) {
+            lane_slots[get_nspe_slot_prio_lane(ns_queue, idx)] |= mask_bits;
         }
+    }
 
-        /*
-         * TODO
-         * The operations are simplified here. Use the SPE mailbox queue
-         * slot with the same idx as that of the NSPE mailbox queue slot.
-         * A more general implementation should dynamically search and
-         * select an empty SPE mailbox queue slot.
-         */
-        clear_spe_queue_empty_status(idx);
-        spe_mailbox_queue.queue[idx].ns_slot_idx = idx;
-
-        msg_ptr = &spe_mailbox_queue.queue[idx].msg;
-        spm_memcpy(msg_ptr, &ns_queue->queue[idx].msg, sizeof(*msg_ptr));
-
-        if (check_mailbox_msg(msg_ptr) != MAILBOX_SUCCESS) {
-            mailbox_clean_queue_slot(idx);
-            continue;
-        }
-
-        get_spe_mailbox_msg_handle(idx,
-                                   &spe_mailbox_queue.queue[idx].msg_handle);
-
-        /*
-         * Set the current slot index under processing.
-         * The value is used in mailbox_get_caller_data() to identify the
-         * mailbox queue slot.
-         */
-        spe_mailbox_queue.cur_proc_slot_idx = idx;
+    /* Handle the pending slots from the highest priority lane */
+    for (lane = 0; lane < MAILBOX_PRIO_LANE_NUM; lane++) {
+        for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
+            mask_bits = (1 << idx);
+            if (!(lane_slots[lane] & mask_bits)) {
+                continue;
+            }
 
-        if (tfm_mailbox_dispatch(msg_ptr, idx, &reply_slots) != MAILBOX_SUCCESS) {
-            mailbox_clean_queue_slot(idx);
-            continue;
+            if (mailbox_handle_slot(ns_queue, idx, &is_urgent)) {
+                reply_slots |= mask_bits;
+                nr_replies++;
+                is_any_urgent |= is_urgent;
+            }
         }
-
-        /* Clean up the current slot index under processing */
-        spe_mailbox_queue.cur_proc_slot_idx = NUM_MAILBOX_QUEUE_SLOT;
     }
 
     tfm_mailbox_hal_enter_critical();
@@ -349,16 +793,18 @@ int32_t tfm_mailbox_handle_msg(void)
     tfm_mailbox_hal_exit_critical();
 
     if (reply_slots) {
-        tfm_mailbox_hal_notify_peer();
+        mailbox_notify_reply(nr_replies, true, is_any_urgent);
     }
 
     return MAILBOX_SUCCESS;
 }
+#endif /* MAILBOX_RING_TRANSPORT */
 
 int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
 {
     uint8_t idx;
     int32_t ret;
+    bool is_urgent, need_notify;
     struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
 
     SPM_ASSERT(ns_queue != NULL);
@@ -382,8 +828,15 @@ int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
         return MAILBOX_NO_PEND_EVENT;
     }
 
+    /* The slot is cleaned once replied, keep the flag */
+    is_urgent = !!(spe_mailbox_queue.queue[idx].msg.call_type &
+                   MAILBOX_URGENT_REPLY);
+
     mailbox_direct_reply(idx, (uint32_t)reply);
 
+#ifdef MAILBOX_RING_TRANSPORT
+    need_notify = set_nspe_queue_replied_ring(ns_queue, idx);
+#else
     tfm_mailbox_hal_enter_critical();
 
     /* Set the NSPE mailbox replied status */
@@ -391,11 +844,32 @@ int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
 
     tfm_mailbox_hal_exit_critical();
 
-    tfm_mailbox_hal_notify_peer();
+    need_notify = true;
+#endif /* MAILBOX_RING_TRANSPORT */
+
+    mailbox_notify_reply(1, need_notify, is_urgent);
 
     return MAILBOX_SUCCESS;
 }
 
+void tfm_mailbox_flush_reply_notify(void)
+{
+#if CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM > 1
+    struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
+    bool need_notify;
+
+    CRITICAL_SECTION_ENTER(cs_assert);
+    need_notify = (reply_notify_pend_num != 0);
+    reply_notify_pend_num = 0;
+    CRITICAL_SECTION_LEAVE(cs_assert);
+
+    if (need_notify) {
+        MAILBOX_STATS_ADD(spe_mailbox_queue.ns_queue, nr_reply_notify, 1);
+        tfm_mailbox_hal_notify_peer();
+    }
+#endif
+}
+
 /* RPC handle_req() callback */
 static void mailbox_handle_req(void)
 {
@@ -440,13 +914,22 @@ static const struct tfm_rpc_ops_t mailbox_rpc_ops = {
 int32_t tfm_mailbox_init(void)
 {
     int32_t ret;
+#ifdef MAILBOX_RING_TRANSPORT
+    uint8_t idx;
+#endif
 
     spm_memset(&spe_mailbox_queue, 0, sizeof(spe_mailbox_queue));
 
+#ifdef MAILBOX_RING_TRANSPORT
+    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
+        set_spe_queue_empty_status(idx);
+    }
+#else
     spe_mailbox_queue.empty_slots =
             (mailbox_queue_status_t)((1UL << (NUM_MAILBOX_QUEUE_SLOT - 1)) - 1);
     spe_mailbox_queue.empty_slots +=
             (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
+#endif
 
     /* Register RPC callbacks */
     ret = tfm_rpc_register_ops(&mailbox_rpc_ops);
@@ -466,6 +949,10 @@ int32_t tfm_mailbox_init(void)
         return ret;
     }
 
+#if NUM_MAILBOX_SHM_BUF > 0
+    mailbox_shm_buf_init();
+#endif
+
     return MAILBOX_SUCCESS;
 }
 
@@ -24,10 +24,24 @@ struct secure_mailbox_slot_t {
 };
 
 struct secure_mailbox_queue_t {
+#ifdef MAILBOX_RING_TRANSPORT
+    bool                         is_empty[NUM_MAILBOX_QUEUE_SLOT];
+                                                   /* empty status of slots */
+#else
     mailbox_queue_status_t       empty_slots;      /* bitmask of empty slots */
+#endif
 
     struct secure_mailbox_slot_t queue[NUM_MAILBOX_QUEUE_SLOT];
     struct ns_mailbox_queue_t    *ns_queue;
+#if NUM_MAILBOX_SHM_BUF > 0
+    struct mailbox_shm_buf_t     shm_buf[NUM_MAILBOX_SHM_BUF];
+                                                    /*
+                                                     * Copy of the shared
+                                                     * payload buffers validated
+                                                     * at initialization
+                                                     */
+    uint32_t                     nr_shm_buf;
+#endif
     uint8_t                      cur_proc_slot_idx; /*
                                                      * The index of mailbox
                                                      * queue slot currently
@@ -55,6 +69,13 @@ int32_t tfm_mailbox_handle_msg(void);
  */
 int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply);
 
+/**
+ * \brief Notify NSPE of the coalesced replies at once.
+ *        Called by the platform when the deadline started by
+ *        \ref tfm_mailbox_hal_start_reply_timer() expires.
+ */
+void tfm_mailbox_flush_reply_notify(void);
+
 /**
  * \brief SPE mailbox initialization
  *
@@ -82,6 +103,18 @@ int32_t tfm_mailbox_hal_init(struct secure_mailbox_queue_t *s_queue);
  */
 int32_t tfm_mailbox_hal_notify_peer(void);
 
+/**
+ * \brief Start the deadline of a coalesced reply notification.
+ *        Implemented by platform specific timer driver. The platform calls
+ *        \ref tfm_mailbox_flush_reply_notify() when the deadline expires. A
+ *        running deadline is restarted.
+ *
+ * \note  Only required when CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM > 1.
+ *
+ * \param[in] timeout_us        The deadline in microseconds.
+ */
+void tfm_mailbox_hal_start_reply_timer(uint32_t timeout_us);
+
 /**
  * \brief Enter critical section of NSPE mailbox
  */
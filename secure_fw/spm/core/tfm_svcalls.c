@@ -13,6 +13,7 @@
 #include "internal_status_code.h"
 #include "memory_symbols.h"
 #include "spm.h"
+#include "spm_service_stats.h"
 #include "svc_num.h"
 #include "tfm_arch.h"
 #include "tfm_svcalls.h"
@@ -74,6 +75,9 @@ static psa_api_svc_func_t psa_api_svc_func_table[] = {
     (psa_api_svc_func_t)tfm_spm_partition_psa_reset_signal,
     (psa_api_svc_func_t)tfm_spm_agent_psa_call,
     (psa_api_svc_func_t)tfm_spm_agent_psa_connect,
+    (psa_api_svc_func_t)tfm_spm_client_psa_call_batch,
+    (psa_api_svc_func_t)tfm_spm_client_psa_call_async,
+    (psa_api_svc_func_t)tfm_spm_client_psa_get_reply,
 };
 
 static uint32_t thread_mode_spm_return(uint32_t result)
@@ -183,6 +187,20 @@ static uint32_t handle_spm_svc_requests(uint32_t svc_number, uint32_t exc_return
     case TFM_SVC_GET_BOOT_DATA:
         tfm_core_get_boot_data_handler(svc_args);
         break;
+    case TFM_SVC_GET_BOOT_DATA_TLV:
+        tfm_core_get_boot_data_tlv_handler(svc_args);
+        break;
+#ifdef CONFIG_TFM_SPM_SERVICE_STATS
+    case TFM_SVC_GET_SERVICE_STATS:
+        tfm_spm_get_service_stats_handler(svc_args);
+        break;
+    case TFM_SVC_RESET_SERVICE_STATS:
+        tfm_spm_reset_service_stats_handler(svc_args);
+        break;
+    case TFM_SVC_GET_CONN_POOL_STATS:
+        tfm_spm_get_conn_pool_stats_handler(svc_args);
+        break;
+#endif
 #if (TFM_ISOLATION_LEVEL != 1) && (CONFIG_TFM_FLIH_API == 1)
     case TFM_SVC_PREPARE_DEPRIV_FLIH:
         exc_return = tfm_flih_prepare_depriv_flih((struct partition_t *)svc_args[0],
@@ -8,7 +8,9 @@
  *
  */
 
+#include <stdbool.h>
 #include <stdint.h>
+#include "cmsis_compiler.h"
 #include "thread.h"
 #include "tfm_arch.h"
 #include "utilities.h"
@@ -18,12 +20,18 @@
 struct thread_t *p_curr_thrd;
 
 /* Force ZERO in case ZI(bss) clear is missing. */
-static struct thread_t *p_thrd_head = NULL; /* Point to the first thread. */
-static struct thread_t *p_rnbl_head = NULL; /* Point to the first runnable. */
+static struct thread_t *rq_heads[THRD_RQ_NUM] = {NULL}; /* Run queues.    */
+static uint32_t rq_ready_map = 0;               /* Non-empty run queues.  */
 
 /* Define Macro to fetch global to support future expansion (PERCPU e.g.) */
-#define LIST_HEAD   p_thrd_head
-#define RNBL_HEAD   p_rnbl_head
+#define RQ_HEAD(idx)    rq_heads[idx]
+#define RQ_READY_MAP    rq_ready_map
+
+/* Run queue 'idx' is represented by bit (31 - idx) to be found with CLZ. */
+#define RQ_READY_BIT(idx)   (1UL << (THRD_RQ_NUM - 1 - (idx)))
+
+#define IS_STATE_QUEUED(state)  (((state) == THRD_STATE_RUNNABLE) || \
+                                 ((state) == THRD_STATE_RET_VAL_AVAIL))
 
 /* Callback function pointer for thread to query current state. */
 static thrd_query_state_t query_state_cb = (thrd_query_state_t)NULL;
@@ -33,83 +41,136 @@ void thrd_set_query_callback(thrd_query_state_t fn)
     query_state_cb = fn;
 }
 
+/*
+ * Queue the thread behind the threads with a higher or the same priority in
+ * its run queue. Threads with the same priority are served in FIFO order.
+ */
+static void rq_enqueue(struct thread_t *p_thrd)
+{
+    uint32_t idx = THRD_PRIOR_TO_RQ(p_thrd->priority);
+    struct thread_t *iter = RQ_HEAD(idx);
+
+    if (iter == NULL || p_thrd->priority < iter->priority) {
+        p_thrd->prev = NULL;
+        p_thrd->next = iter;
+        if (iter) {
+            iter->prev = p_thrd;
+        }
+        RQ_HEAD(idx) = p_thrd;
+        RQ_READY_MAP |= RQ_READY_BIT(idx);
+        return;
+    }
+
+    while (iter->next && (iter->next->priority <= p_thrd->priority)) {
+        iter = iter->next;
+    }
+
+    p_thrd->prev = iter;
+    p_thrd->next = iter->next;
+    if (iter->next) {
+        iter->next->prev = p_thrd;
+    }
+    iter->next = p_thrd;
+}
+
+static void rq_dequeue(struct thread_t *p_thrd)
+{
+    uint32_t idx = THRD_PRIOR_TO_RQ(p_thrd->priority);
+
+    if (p_thrd->prev) {
+        p_thrd->prev->next = p_thrd->next;
+    } else {
+        RQ_HEAD(idx) = p_thrd->next;
+    }
+
+    if (p_thrd->next) {
+        p_thrd->next->prev = p_thrd->prev;
+    }
+
+    p_thrd->next = NULL;
+    p_thrd->prev = NULL;
+
+    if (RQ_HEAD(idx) == NULL) {
+        RQ_READY_MAP &= ~RQ_READY_BIT(idx);
+    }
+}
+
 struct thread_t *thrd_next(void)
 {
-    struct thread_t *p_thrd = RNBL_HEAD;
+    struct thread_t *p_thrd = NULL;
     uint32_t retval = 0;
     struct critical_section_t cs_signal = CRITICAL_SECTION_STATIC_INIT;
 
     CRITICAL_SECTION_ENTER(cs_signal);
     /*
-     * First runnable thread has highest priority since threads are
-     * sorted by priority.
+     * The head of the highest priority non-empty run queue is the next
+     * thread. Threads woken up by signals get the return value delivered
+     * when they are picked.
      */
-    while (p_thrd) {
-        /* Change thread state if any signal changed */
-        p_thrd->state = query_state_cb(p_thrd, &retval);
+    while (RQ_READY_MAP) {
+        p_thrd = RQ_HEAD(__CLZ(RQ_READY_MAP));
 
-        if (p_thrd->state == THRD_STATE_RET_VAL_AVAIL) {
-            tfm_arch_set_context_ret_code(p_thrd->p_context_ctrl, retval);
-            p_thrd->state = THRD_STATE_RUNNABLE;
+        if (p_thrd->state != THRD_STATE_RET_VAL_AVAIL) {
+            break;
         }
 
-        if (p_thrd->state == THRD_STATE_RUNNABLE) {
+        if (query_state_cb(p_thrd, &retval) == THRD_STATE_RET_VAL_AVAIL) {
+            tfm_arch_set_context_ret_code(p_thrd->p_context_ctrl, retval);
+            p_thrd->state = THRD_STATE_RUNNABLE;
             break;
         }
 
-        p_thrd = p_thrd->next;
+        /* Woken up without an available signal, back to wait. */
+        thrd_set_state(p_thrd, THRD_STATE_BLOCK);
+        p_thrd = NULL;
     }
     CRITICAL_SECTION_LEAVE(cs_signal);
 
     return p_thrd;
 }
 
-static void insert_by_prior(struct thread_t **head, struct thread_t *node)
-{
-    if (*head == NULL || (node->priority <= (*head)->priority)) {
-        node->next = *head;
-        *head = node;
-    } else {
-        struct thread_t *iter = *head;
-
-        while (iter->next && (node->priority > iter->next->priority)) {
-            iter = iter->next;
-        }
-
-        node->next = iter->next;
-        iter->next = node;
-    }
-}
-
 void thrd_start(struct thread_t *p_thrd, thrd_fn_t fn, thrd_fn_t exit_fn, void *param)
 {
     SPM_ASSERT(p_thrd != NULL);
 
-    /* Insert a new thread with priority */
-    insert_by_prior(&LIST_HEAD, p_thrd);
-
     tfm_arch_init_context(p_thrd->p_context_ctrl, (uintptr_t)fn, param,
                           (uintptr_t)exit_fn);
 
-    /* Mark it as RUNNABLE after insertion */
+    /* Mark it as RUNNABLE, which inserts it into the run queue */
     thrd_set_state(p_thrd, THRD_STATE_RUNNABLE);
 }
 
 void thrd_set_state(struct thread_t *p_thrd, uint32_t new_state)
 {
+    bool was_queued;
+
     SPM_ASSERT(p_thrd != NULL);
 
+    was_queued = IS_STATE_QUEUED(p_thrd->state);
+
     p_thrd->state = new_state;
 
-    /*
-     * Set first runnable thread as head to reduce enumerate
-     * depth while searching for a first runnable thread.
-     */
-    if ((p_thrd->state == THRD_STATE_RUNNABLE) &&
-        ((RNBL_HEAD == NULL) || (p_thrd->priority < RNBL_HEAD->priority))) {
-        RNBL_HEAD = p_thrd;
+    if (!was_queued && IS_STATE_QUEUED(new_state)) {
+        rq_enqueue(p_thrd);
+    } else if (was_queued && !IS_STATE_QUEUED(new_state)) {
+        rq_dequeue(p_thrd);
+    }
+}
+
+void thrd_set_priority(struct thread_t *p_thrd, uint32_t priority)
+{
+    SPM_ASSERT(p_thrd != NULL);
+
+    if (p_thrd->priority == (uint8_t)priority) {
+        return;
+    }
+
+    if (IS_STATE_QUEUED(p_thrd->state)) {
+        rq_dequeue(p_thrd);
+        p_thrd->priority = (uint8_t)priority;
+        rq_enqueue(p_thrd);
     } else {
-        RNBL_HEAD = LIST_HEAD;
+        p_thrd->priority = (uint8_t)priority;
     }
 }
 
@@ -29,6 +29,15 @@
 #define THRD_PRIOR_LOW            0x7F
 #define THRD_PRIOR_LOWEST         0xFF
 
+/*
+ * Runnable threads are kept in per-priority-group run queues. Each group
+ * covers (1 << THRD_RQ_PRIOR_SHIFT) consecutive priority values and owns one
+ * bit in the ready bitmap, bit 31 being the highest priority group.
+ */
+#define THRD_RQ_PRIOR_SHIFT       3
+#define THRD_RQ_NUM               32
+#define THRD_PRIOR_TO_RQ(prio)    ((uint32_t)(prio) >> THRD_RQ_PRIOR_SHIFT)
+
 /* Error codes */
 #define THRD_SUCCESS              0
 #define THRD_ERR_GENERIC          1
@@ -45,7 +54,8 @@ struct thread_t {
     uint8_t         state;              /* State                             */
     uint16_t        flags;              /* Flags and align, DO NOT REMOVE!   */
     void            *p_context_ctrl;    /* Context control (sp, splimit, lr) */
-    struct thread_t *next;              /* Next thread in list               */
+    struct thread_t *next;              /* Next thread in run queue          */
+    struct thread_t *prev;              /* Previous thread in run queue      */
 };
 
 /* Query thread state function type */
@@ -71,20 +81,23 @@ extern struct thread_t *p_curr_thrd;
                         (p_thrd)->state          = THRD_STATE_CREATING;  \
                         (p_thrd)->flags          = 0;                    \
                         (p_thrd)->p_context_ctrl = p_ctx_ctrl;           \
+                        (p_thrd)->next           = NULL;                 \
+                        (p_thrd)->prev           = NULL;                 \
                     } while (0)
 
 /*
- * Set thread priority.
+ * Set thread priority. A queued thread is moved to the run queue of the new
+ * priority, behind the threads of the same priority.
  *
  * Parameters :
  *  p_thrd         -     Pointer of thread_t struct
  *  priority       -     Priority value (0~255)
  *
  * Note :
- *  The new priority may not take effect immediately.
+ *  - Caller needs to protect the run queues against concurrent access.
+ *  - The new priority takes effect at the next scheduling.
  */
-#define THRD_SET_PRIORITY(p_thrd, priority) \
-                                        p_thrd->priority = (uint8_t)(priority)
+void thrd_set_priority(struct thread_t *p_thrd, uint32_t priority);
 
 /*
  * Update current thread's bound context pointer.
@@ -104,11 +117,16 @@ extern struct thread_t *p_curr_thrd;
 void thrd_set_query_callback(thrd_query_state_t fn);
 
 /*
- * Set thread state, and updates the runnable head.
+ * Set thread state, and move the thread in or out of the run queues.
+ * Threads in state THRD_STATE_RUNNABLE or THRD_STATE_RET_VAL_AVAIL are
+ * queued, threads in other states are not.
  *
  * Parameters :
  *  p_thrd         -     Pointer of thread_t struct
  *  new_state      -     New state of thread
+ *
+ * Note :
+ *  Caller needs to protect the run queues against concurrent access.
  */
 void thrd_set_state(struct thread_t *p_thrd, uint32_t new_state);
 
@@ -127,7 +145,9 @@ void thrd_set_state(struct thread_t *p_thrd, uint32_t new_state);
 void thrd_start(struct thread_t *p_thrd, thrd_fn_t fn, thrd_fn_t exit_fn, void *param);
 
 /*
- * Get the next thread to run in list.
+ * Get the next thread to run. The highest priority non-empty run queue is
+ * located with CLZ on the ready bitmap, so the cost does not depend on the
+ * number of threads.
  *
  * Return :
  *  Pointer of next thread to run.
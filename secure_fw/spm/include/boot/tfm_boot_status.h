@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 
 #ifdef __cplusplus
@@ -23,6 +24,7 @@ extern "C" {
 #define TLV_MAJOR_IAS      0x1
 #define TLV_MAJOR_FWU      0x2
 #define TLV_MAJOR_MBS      0x3
+#define TLV_MAJOR_BTL      0x4
 #define TLV_MAJOR_INVALID  0xF
 
 /**
@@ -62,6 +64,8 @@ extern "C" {
  * |---------------------------------------|
  * | MAJOR_MBS   | slot ID  (6) | claim(6) |
  * |---------------------------------------|
+ * | MAJOR_BTL   | stage(4) | sequence(8)  |
+ * |---------------------------------------|
  * | MAJOR_CORE  |          TBD            |
  * |---------------------------------------|
  */
@@ -150,6 +154,52 @@ extern "C" {
                     (MASK_LEFT_SHIFT(sw_module, MODULE_MASK, MODULE_POS) | \
                      MASK_LEFT_SHIFT(claim, CLAIM_MASK, CLAIM_POS))
 
+/* Boot timeline specific macros */
+#define BTL_STAGE_POS  8
+#define BTL_STAGE_MASK 0xF    /* 4 bit */
+#define BTL_SEQ_POS    0
+#define BTL_SEQ_MASK   0xFF   /* 8 bit */
+
+#define GET_BTL_STAGE(tlv_type) \
+                    MASK_RIGHT_SHIFT(tlv_type, MINOR_MASK, BTL_STAGE_POS)
+#define GET_BTL_SEQ(tlv_type) \
+                    MASK_RIGHT_SHIFT(tlv_type, BTL_SEQ_MASK, BTL_SEQ_POS)
+#define SET_BTL_MINOR(stage, seq) \
+                    (MASK_LEFT_SHIFT(stage, BTL_STAGE_MASK, BTL_STAGE_POS) | \
+                     MASK_LEFT_SHIFT(seq, BTL_SEQ_MASK, BTL_SEQ_POS))
+
+/* Boot timeline: boot stages */
+#define BTL_STAGE_BL1_1         0x0
+#define BTL_STAGE_BL1_2         0x1
+#define BTL_STAGE_BL2           0x2
+#define BTL_STAGE_SPM           0x3
+
+/*
+ * Boot timeline: checkpoints. Each checkpoint marks the beginning of a boot
+ * step, which lasts until the next checkpoint. The 'arg' of the checkpoint
+ * is the image ID for the image steps and the partition ID for PART_INIT.
+ */
+#define BTL_CP_START            0x0     /* Stage entry                      */
+#define BTL_CP_IMAGE_COPY       0x1     /* Copy the next image to RAM       */
+#define BTL_CP_IMAGE_DECRYPT    0x2     /* Decrypt the next image           */
+#define BTL_CP_IMAGE_HASH       0x3     /* Hash the next image              */
+#define BTL_CP_SIG_VERIFY       0x4     /* Verify the next image signature  */
+#define BTL_CP_IMAGE_LOAD       0x5     /* Load and validate a whole image  */
+#define BTL_CP_SPM_INIT         0x6     /* Load the Secure Partitions       */
+#define BTL_CP_PART_INIT        0x7     /* A Secure Partition runs at boot  */
+#define BTL_CP_JUMP             0x8     /* Jump to the next image or NSPE   */
+
+/**
+ * Boot timeline checkpoint, the value of a TLV_MAJOR_BTL entry. All fields
+ * in little endian. The timestamp counts from an arbitrary point, only the
+ * differences between checkpoints are meaningful.
+ */
+struct boot_timeline_checkpoint {
+    uint32_t timestamp;
+    uint16_t checkpoint;
+    uint16_t arg;
+};
+
 /* Magic value which marks the beginning of shared data area in memory */
 #define SHARED_DATA_TLV_INFO_MAGIC    0x2016
 
@@ -194,6 +244,25 @@ struct tfm_boot_data {
 #define SHARED_DATA_ENTRY_HEADER_SIZE sizeof(struct shared_data_tlv_entry)
 #define SHARED_DATA_ENTRY_SIZE(size) (size + SHARED_DATA_ENTRY_HEADER_SIZE)
 
+/**
+ * \brief Initialize the shared data area with an empty TLV section, unless it
+ *        already holds a valid one.
+ *
+ * \param[in] boot_data  The shared data area.
+ * \param[in] size       The size of the shared data area.
+ */
+static inline void boot_shared_data_init(struct tfm_boot_data *boot_data,
+                                         size_t size)
+{
+    if ((boot_data->header.tlv_magic != SHARED_DATA_TLV_INFO_MAGIC) ||
+        (boot_data->header.tlv_tot_len > size)) {
+
+        memset((void *)boot_data, 0, size);
+        boot_data->header.tlv_magic   = SHARED_DATA_TLV_INFO_MAGIC;
+        boot_data->header.tlv_tot_len = SHARED_DATA_HEADER_SIZE;
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
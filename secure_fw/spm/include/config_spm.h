@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -19,6 +19,16 @@
 #endif
 #endif
 
+#ifndef CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM
+#pragma message("CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM is defaulted to 32. Please check and set it explicitly.")
+#define CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM 32
+#endif
+
+#ifndef CONFIG_TFM_PSA_CALL_BATCH_MAX_NUM
+#pragma message("CONFIG_TFM_PSA_CALL_BATCH_MAX_NUM is defaulted to 8. Please check and set it explicitly.")
+#define CONFIG_TFM_PSA_CALL_BATCH_MAX_NUM 8
+#endif
+
 /* Set the doorbell APIs */
 #ifndef CONFIG_TFM_DOORBELL_API
 #if CONFIG_TFM_SPM_BACKEND_IPC == 1
@@ -27,9 +37,36 @@
 #endif /* CONFIG_TFM_SPM_BACKEND_IPC == 1 */
 #endif /* !CONFIG_TFM_DOORBELL_API */
 
+/* Set the asynchronous client APIs */
+#ifndef CONFIG_TFM_ASYNC_CALL_API
+#define CONFIG_TFM_ASYNC_CALL_API      0
+#endif
+
+/* Set the direct calls to SFN partitions in IPC backend */
+#ifndef CONFIG_TFM_SFN_DIRECT_CALL
+#define CONFIG_TFM_SFN_DIRECT_CALL     0
+#endif
+
+/* Set the mailbox reply notification coalescing, notify each reply */
+#ifndef CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM
+#define CONFIG_TFM_MAILBOX_REPLY_COALESCE_NUM  1
+#endif
+
+#ifndef CONFIG_TFM_MAILBOX_REPLY_TIMEOUT_US
+#define CONFIG_TFM_MAILBOX_REPLY_TIMEOUT_US    100
+#endif
+
 /* Check invalid configs */
 #if (CONFIG_TFM_SPM_BACKEND_SFN == 1) && CONFIG_TFM_DOORBELL_API
 #error "Invalid config: CONFIG_TFM_SPM_BACKEND_SFN AND CONFIG_TFM_DOORBELL_API!"
 #endif
 
+#if (CONFIG_TFM_SPM_BACKEND_SFN == 1) && CONFIG_TFM_ASYNC_CALL_API
+#error "Invalid config: CONFIG_TFM_SPM_BACKEND_SFN AND CONFIG_TFM_ASYNC_CALL_API!"
+#endif
+
+#if (CONFIG_TFM_SPM_BACKEND_SFN == 1) && CONFIG_TFM_SFN_DIRECT_CALL
+#error "Invalid config: CONFIG_TFM_SPM_BACKEND_SFN AND CONFIG_TFM_SFN_DIRECT_CALL!"
+#endif
+
 #endif /* __CONFIG_PARTITION_SPM_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -9,10 +9,27 @@
 #define __BACKEND_IPC_H__
 
 #include <stdint.h>
+#include "psa/error.h"
+
+struct connection_t;
 
 /* Calculate the service setting. In IPC it is the signal set. */
 #define BACKEND_SERVICE_SET(set, p_service) ((set) |= (p_service)->signal)
 
+/*
+ * Send the chained messages of a batch one after another, linked by
+ * 'p_batch_next'. The client is blocked until the last one is replied, and
+ * gets 'status' or the first negative status replied by the services.
+ */
+psa_status_t backend_messaging_batch(struct connection_t *p_head,
+                                     psa_status_t status);
+
+/*
+ * Send a message without blocking the client. The reply is queued to the
+ * client and signalled with ASYNC_CALL_REPLY.
+ */
+psa_status_t backend_messaging_async(struct connection_t *p_connection);
+
 /*
  * Actions done before entering SPM.
  *
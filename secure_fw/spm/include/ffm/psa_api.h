@@ -16,6 +16,7 @@
 #endif
 #include "psa/client.h"
 #include "psa/service.h"
+#include "tfm_psa_call_batch.h"
 
 #if PSA_FRAMEWORK_HAS_MM_IOVEC
 
@@ -204,6 +205,25 @@ psa_status_t tfm_spm_client_psa_call(psa_handle_t handle,
                                      const psa_invec *inptr,
                                      psa_outvec *outptr);
 
+/**
+ * \brief handler for \ref psa_call_batch.
+ *
+ * \param[in,out] calls         Array of request descriptors.
+ * \param[in] ctrl_param        Number of descriptors, combined with the
+ *                              non-secure flag of the descriptors.
+ *
+ * \retval PSA_SUCCESS          All the requests returned non-negative status.
+ * \retval <0                   The first negative status of the requests.
+ * \retval "Does not return"    The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           An invalid memory reference was provided.
+ * \arg                           The number of descriptors exceeds
+ *                                CONFIG_TFM_PSA_CALL_BATCH_MAX_NUM.
+ * \arg                           A request is invalid as for \ref psa_call.
+ */
+psa_status_t tfm_spm_client_psa_call_batch(psa_call_desc_t *calls,
+                                           uint32_t ctrl_param);
+
 /* Following PSA APIs are only needed by connection-based services */
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
 
@@ -407,6 +427,57 @@ psa_status_t tfm_spm_partition_psa_clear(void);
 #define tfm_spm_partition_psa_clear     NULL
 #endif /* CONFIG_TFM_DOORBELL_API == 1 */
 
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+/**
+ * \brief handler for \ref psa_call_async.
+ *
+ * \param[in] handle            Service handle to the established connection,
+ *                              \ref psa_handle_t
+ * \param[in] ctrl_param        Parameters combined in uint32_t,
+ *                              includes request type, in_num and out_num.
+ * \param[in] inptr             Array of input psa_invec structures.
+ *                              \ref psa_invec
+ * \param[in] outptr            Array of output psa_outvec structures.
+ *                              \ref psa_outvec
+ *
+ * \retval >0                   Handle identifying the request in
+ *                              \ref psa_get_reply.
+ * \retval PSA_ERROR_CONNECTION_BUSY
+ *                              No connection is available for a stateless
+ *                              handle.
+ * \retval PSA_ERROR_PROGRAMMER_ERROR
+ *                              The caller is an NS agent. Programmer errors
+ *                              are returned to NS agents as for
+ *                              \ref psa_call.
+ * \retval "Does not return"    The call is invalid as for \ref psa_call, or
+ *                              the connection is handling a request.
+ */
+psa_handle_t tfm_spm_client_psa_call_async(psa_handle_t handle,
+                                           uint32_t ctrl_param,
+                                           const psa_invec *inptr,
+                                           psa_outvec *outptr);
+
+/**
+ * \brief handler for \ref psa_get_reply.
+ *
+ * \param[out] p_request        The handle of the replied request, as returned
+ *                              by \ref psa_call_async.
+ *
+ * \retval >=0                  The reply status of the request.
+ * \retval <0                   The error status of the request.
+ * \retval PSA_ERROR_PROGRAMMER_ERROR
+ *                              The caller is an NS agent.
+ * \retval "Does not return"    The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           An invalid memory reference was provided.
+ * \arg                           No reply is available.
+ */
+psa_status_t tfm_spm_client_psa_get_reply(psa_handle_t *p_request);
+#else
+#define tfm_spm_client_psa_call_async   NULL
+#define tfm_spm_client_psa_get_reply    NULL
+#endif /* CONFIG_TFM_ASYNC_CALL_API == 1 */
+
 /**
  * \brief Function body of \ref psa_panic.
  *
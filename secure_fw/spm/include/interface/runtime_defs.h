@@ -17,6 +17,7 @@
 #include "psa/client.h"
 #include "psa/error.h"
 #include "psa/service.h"
+#include "tfm_psa_call_batch.h"
 #include "ffm/agent_api.h"
 
 /* SFN defs */
@@ -40,6 +41,7 @@ struct psa_api_tbl_t {
     void             (*psa_reply)(psa_handle_t msg_handle, psa_status_t retval);
     void             (*psa_panic)(void);
     uint32_t         (*psa_rot_lifecycle_state)(void);
+    psa_status_t     (*psa_call_batch)(psa_call_desc_t *calls, uint32_t ctrl_param);
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
     psa_handle_t     (*psa_connect)(uint32_t sid, uint32_t version);
     void             (*psa_close)(psa_handle_t handle);
@@ -49,6 +51,11 @@ struct psa_api_tbl_t {
     void             (*psa_notify)(int32_t partition_id);
     void             (*psa_clear)(void);
 #endif /* CONFIG_TFM_DOORBELL_API == 1 */
+#if CONFIG_TFM_ASYNC_CALL_API == 1
+    psa_handle_t     (*psa_call_async)(psa_handle_t handle, uint32_t ctrl_param,
+                                       const psa_invec *in_vec, psa_outvec *out_vec);
+    psa_status_t     (*psa_get_reply)(psa_handle_t *p_request);
+#endif /* CONFIG_TFM_ASYNC_CALL_API == 1 */
 #if CONFIG_TFM_FLIH_API == 1 || CONFIG_TFM_SLIH_API == 1
     void             (*psa_irq_enable)(psa_signal_t irq_signal);
     psa_irq_status_t (*psa_irq_disable)(psa_signal_t irq_signal);
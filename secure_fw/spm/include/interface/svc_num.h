@@ -73,6 +73,10 @@
 #define TFM_SVC_OUTPUT_UNPRIV_STRING    TFM_SVC_NUM_SPM_THREAD(2)
 #define TFM_SVC_GET_BOOT_DATA           TFM_SVC_NUM_SPM_THREAD(3)
 #define TFM_SVC_THREAD_MODE_SPM_RETURN  TFM_SVC_NUM_SPM_THREAD(4)
+#define TFM_SVC_GET_BOOT_DATA_TLV       TFM_SVC_NUM_SPM_THREAD(5)
+#define TFM_SVC_GET_SERVICE_STATS       TFM_SVC_NUM_SPM_THREAD(6)
+#define TFM_SVC_RESET_SERVICE_STATS     TFM_SVC_NUM_SPM_THREAD(7)
+#define TFM_SVC_GET_CONN_POOL_STATS     TFM_SVC_NUM_SPM_THREAD(8)
 
 /* TF-M SPM and for Handler mode */
 #define TFM_SVC_PREPARE_DEPRIV_FLIH     TFM_SVC_NUM_SPM_HANDLER(0)
@@ -102,6 +106,9 @@
 #define TFM_SVC_PSA_RESET_SIGNAL        TFM_SVC_NUM_PSA_API_THREAD(19)
 #define TFM_SVC_AGENT_PSA_CALL          TFM_SVC_NUM_PSA_API_THREAD(20)
 #define TFM_SVC_AGENT_PSA_CONNECT       TFM_SVC_NUM_PSA_API_THREAD(21)
+#define TFM_SVC_PSA_CALL_BATCH          TFM_SVC_NUM_PSA_API_THREAD(22)
+#define TFM_SVC_PSA_CALL_ASYNC          TFM_SVC_NUM_PSA_API_THREAD(23)
+#define TFM_SVC_PSA_GET_REPLY           TFM_SVC_NUM_PSA_API_THREAD(24)
 
 #define TFM_SVC_IS_PLATFORM(svc_num)        (!!((svc_num) & TFM_SVC_NUM_PLATFORM_MSK))
 #define TFM_SVC_IS_HANDLER_MODE(svc_num)    (!!((svc_num) & TFM_SVC_NUM_HANDLER_MODE_MSK))
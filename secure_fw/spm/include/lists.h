@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -107,4 +107,36 @@ struct bi_list_node_t {
          node != NULL;                                       \
          pnode = &(node)->link, node = (node)->link)
 
+/********* Uni-directional FIFO queue operations ********/
+/*
+ * A queue is described by a head and a tail pointer, nodes are linked
+ * through 'link'. An empty queue has both pointers NULL.
+ */
+
+/* Is queue empty? */
+#define UNI_QUEUE_IS_EMPTY(head)        ((head) == NULL)
+
+/* Append a node at the tail of the queue. */
+#define UNI_QUEUE_PUSH(head, tail, node, link) do {     \
+    (node)->link = NULL;                                \
+    if ((tail) == NULL) {                               \
+        (head) = (node);                                \
+    } else {                                            \
+        (tail)->link = (node);                          \
+    }                                                   \
+    (tail) = (node);                                    \
+} while (0)
+
+/* Take the node at the head of the queue, 'node' gets NULL if empty. */
+#define UNI_QUEUE_POP(head, tail, node, link) do {      \
+    (node) = (head);                                    \
+    if ((node) != NULL) {                               \
+        (head) = (node)->link;                          \
+        if ((head) == NULL) {                           \
+            (tail) = NULL;                              \
+        }                                               \
+        (node)->link = NULL;                            \
+    }                                                   \
+} while (0)
+
 #endif /* __LISTS_H__ */
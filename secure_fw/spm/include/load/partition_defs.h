@@ -26,10 +26,10 @@
 /*
  * Partition flag start
  *
- * 31      12 11 10  9   8  7         0
- * +---------+--+--+---+---+----------+
- * | RES[20] |TZ|MB|I/S|A/P| Priority |
- * +---------+--+--+---+---+----------+
+ * 31      13 12 11 10  9   8  7         0
+ * +---------+--+--+--+---+---+----------+
+ * | RES[19] |LZ|TZ|MB|I/S|A/P| Priority |
+ * +---------+--+--+--+---+---+----------+
  *
  * Field                Desc                        Value
  * Priority, bits[7:0]:  Partition Priority          Lowest, low, normal, high, hightest
@@ -37,7 +37,8 @@
  * I/S, bit[9]:          IPC or SFN typed partition  1: IPC               0: SFN
  * MB,  bit[10]:         NS Agent Mailbox or not     1: NS Agent mailbox  0: Not
  * TZ,  bit[11]:         NS Agent TZ or not          1: NS Agent TZ       0: Not
- * RES, bits[31:12]:     20 bits reserved            0
+ * LZ,  bit[12]:         Lazy start or not           1: Lazy start        0: Not
+ * RES, bits[31:13]:     19 bits reserved            0
  */
 #define PARTITION_PRI_HIGHEST                   (0x0)
 #define PARTITION_PRI_HIGH                      (0xF)
@@ -52,6 +53,8 @@
 #define PARTITION_NS_AGENT_MB                   (1UL << 10)
 #define PARTITION_NS_AGENT_TZ                   (1UL << 11)
 
+#define PARTITION_LAZY_START                    (1UL << 12)
+
 #define PARTITION_PRIORITY(flag)                ((flag) & PARTITION_PRI_MASK)
 #define TO_THREAD_PRIORITY(x)                   (x)
 
@@ -67,6 +70,8 @@
                                                      & PARTITION_MODEL_IPC))
 #define IS_NS_AGENT(pldi)                       (!!((pldi)->flags \
                                                      & (PARTITION_NS_AGENT_MB | PARTITION_NS_AGENT_TZ)))
+#define IS_LAZY_START(pldi)                     (!!((pldi)->flags \
+                                                     & PARTITION_LAZY_START))
 #ifdef CONFIG_TFM_USE_TRUSTZONE
 #define IS_NS_AGENT_TZ(pldi)                    (!!((pldi)->flags & PARTITION_NS_AGENT_TZ))
 #else
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2023, Arm Limited. All rights reserved.
  * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -22,7 +22,7 @@
 #define NO_MORE_PARTITION        NULL
 
 /* Length of extendable variables in partition load type */
-#define LOAD_INFO_EXT_LENGTH                        (2)
+#define LOAD_INFO_EXT_LENGTH                        (3)
 /* Argument "pldinf" must be a "struct partition_load_info_t *". */
 #define LOAD_INFSZ_BYTES(pldinf)                                       \
     (sizeof(*(pldinf)) + LOAD_INFO_EXT_LENGTH * sizeof(uintptr_t) +    \
@@ -34,6 +34,10 @@
 /* 'Allocate' stack based on load info */
 #define LOAD_ALLOCED_STACK_ADDR(pldinf)    (*((uintptr_t *)(pldinf + 1)))
 
+/* Dependency bitmap indexed by SID hash slot, NULL if no dependencies */
+#define LOAD_INFO_DEPS_BITMAP(pldinf)                                  \
+    ((const uint32_t *)(((const uintptr_t *)(pldinf + 1))[2]))
+
 #define LOAD_INFO_DEPS(pldinf)                                         \
     ((const uint32_t *)((uintptr_t)(pldinf + 1) + LOAD_INFO_EXT_LENGTH * sizeof(uintptr_t)))
 #define LOAD_INFO_SERVICE(pldinf)                                      \
@@ -52,12 +56,6 @@ struct partition_head_t {
     struct partition_t *next;           /* Next partition node  */
 };
 
-/* Runtime service struct list head node type */
-struct service_head_t {
-    uint32_t reserved;                  /* Reserved             */
-    struct service_t *next;             /* Next partition node  */
-};
-
 /*
  * Load a partition object to linked list and return if a load is successful.
  * An 'assuredly' function, return NO_MORE_PARTITION for no more partitions and
@@ -67,7 +65,8 @@ struct service_head_t {
 struct partition_t *load_a_partition_assuredly(struct partition_head_t *head);
 
 /*
- * Load numbers of service objects to linked list based on given partition.
+ * Load numbers of service objects based on given partition, and put them into
+ * the SID hash table indexed by the build-time SID hash slot.
  * It loads connection based services and stateless services that partition
  * contains.
  * As an 'assuredly' function, errors simply panic the system and never
@@ -76,7 +75,7 @@ struct partition_t *load_a_partition_assuredly(struct partition_head_t *head);
  * ZERO if services are not represented by signals.
  */
 uint32_t load_services_assuredly(struct partition_t *p_partition,
-                                 struct service_head_t *services_listhead,
+                                 struct service_t **sid_hash_tbl,
                                  struct service_t **stateless_services_ref_tbl,
                                  size_t ref_tbl_size);
 
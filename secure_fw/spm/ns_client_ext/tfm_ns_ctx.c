@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -7,26 +7,52 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "cmsis.h"
+#include "critical_section.h"
 #include "tfm_ns_ctx.h"
 #include "tfm_nspm.h"
 
+/* Number of group IDs, the group ID is 8-bit in the client token */
+#define NS_CTX_GID_NUM                      256
+
 /*
  * NS context. Initialized to 0.
  * All contexts are not used as the reference counter is 0 in initialization.
  */
 static struct tfm_ns_ctx_t ns_ctx_data[TFM_NS_CONTEXT_MAX] = {0};
 
+/* Index of the context owned by each group, TFM_NS_CONTEXT_MAX if none */
+static uint8_t gid_to_ns_ctx_index[NS_CTX_GID_NUM];
+
+/* Unused contexts, linked by their indexes. TFM_NS_CONTEXT_MAX ends it. */
+static uint8_t ns_ctx_free_next[TFM_NS_CONTEXT_MAX];
+static uint8_t ns_ctx_free_head = TFM_NS_CONTEXT_MAX;
+
 /* Current active NS context index. Default is invalid index */
 static uint8_t active_ns_ctx_index = TFM_NS_CONTEXT_MAX;
 
+/* Return an unused context to the free list and forget its group. */
+static void free_ns_ctx(uint8_t idx)
+{
+    gid_to_ns_ctx_index[ns_ctx_data[idx].gid] = TFM_NS_CONTEXT_MAX;
+    ns_ctx_free_next[idx] = ns_ctx_free_head;
+    ns_ctx_free_head = idx;
+}
+
 bool init_ns_ctx(void)
 {
     uint32_t i;
 
+    for (i = 0; i < NS_CTX_GID_NUM; i++) {
+        gid_to_ns_ctx_index[i] = TFM_NS_CONTEXT_MAX;
+    }
+
+    /* Link all the contexts, lowest index first */
     for (i = 0; i < TFM_NS_CONTEXT_MAX; i++) {
         /* Only need to ensure the reference counter is 0 */
         ns_ctx_data[i].ref_cnt = 0;
+        ns_ctx_free_next[i] = (uint8_t)(i + 1);
     }
+    ns_ctx_free_head = 0;
 
     active_ns_ctx_index = TFM_NS_CONTEXT_MAX;
     return true;
@@ -34,71 +60,53 @@ bool init_ns_ctx(void)
 
 bool acquire_ns_ctx(uint8_t gid, uint8_t *idx)
 {
-    /* Only support one context slot for now */
-    uint32_t i;
-    uint32_t empty_ctx_idx = TFM_NS_CONTEXT_MAX; /* default is invalid */
-
-    __disable_irq();
-    /*
-     * Go through all context slots to get the context for the given group ID.
-     * It will not take a long time as the context number should be limited.
-     */
-    for (i = 0; i < TFM_NS_CONTEXT_MAX; i++) {
-        if (ns_ctx_data[i].ref_cnt > 0) {  /* This context has been taken */
-            if (ns_ctx_data[i].gid == gid) {
-                /*
-                 * Found the context associated with the input group ID.
-                 * Check if the thread number reached the limit.
-                 */
-                if (ns_ctx_data[i].ref_cnt < TFM_NS_CONTEXT_MAX_TID) {
-                    /* Reuse this context and increase the reference number */
-                    ns_ctx_data[i].ref_cnt++;
-                    *idx = i;
-                    __enable_irq();
-                    return true;
-                } else {
-                    /* No more thread for this group */
-                    __enable_irq();
-                    return false;
-                }
-            }
-        } else {    /* Found an empty context slot */
-            /* Save the first unused context index and continue */
-            if (empty_ctx_idx == TFM_NS_CONTEXT_MAX) {
-                empty_ctx_idx = i;
-            }
-            /*
-             * Still need to go through the remaining slots to check if there
-             * is an existing context assigned to the given group ID.
-             */
+    struct critical_section_t cs_ctx = CRITICAL_SECTION_STATIC_INIT;
+    uint8_t ctx_idx;
+    bool ret = false;
+
+    CRITICAL_SECTION_ENTER(cs_ctx);
+
+    ctx_idx = gid_to_ns_ctx_index[gid];
+    if (ctx_idx < TFM_NS_CONTEXT_MAX) {
+        /*
+         * Reuse the context associated with the input group ID, if the thread
+         * number does not reach the limit.
+         */
+        if (ns_ctx_data[ctx_idx].ref_cnt < TFM_NS_CONTEXT_MAX_TID) {
+            ns_ctx_data[ctx_idx].ref_cnt++;
+            *idx = ctx_idx;
+            ret = true;
         }
+    } else if (ns_ctx_free_head < TFM_NS_CONTEXT_MAX) {
+        /* No existing context for the group ID, take a free context */
+        ctx_idx = ns_ctx_free_head;
+        ns_ctx_free_head = ns_ctx_free_next[ctx_idx];
+
+        ns_ctx_data[ctx_idx].ref_cnt = 1;
+        ns_ctx_data[ctx_idx].gid = gid;
+        gid_to_ns_ctx_index[gid] = ctx_idx;
+        *idx = ctx_idx;
+        ret = true;
     }
 
-    /* No existing context for the group ID, use the first free context */
-    if (empty_ctx_idx < TFM_NS_CONTEXT_MAX) {
-        ns_ctx_data[empty_ctx_idx].ref_cnt++;
-        ns_ctx_data[empty_ctx_idx].gid = gid;
-        *idx = empty_ctx_idx;
-        __enable_irq();
-        return true;
-    } else {
-        __enable_irq();
-        return false;   /* No available context */
-    }
+    CRITICAL_SECTION_LEAVE(cs_ctx);
+    return ret;
 }
 
 bool release_ns_ctx(uint8_t gid, uint8_t tid, uint8_t idx)
 {
+    struct critical_section_t cs_ctx = CRITICAL_SECTION_STATIC_INIT;
+
     /* Check if the index is in range */
     if (idx >= TFM_NS_CONTEXT_MAX) {
         return false;
     }
 
-    __disable_irq();
+    CRITICAL_SECTION_ENTER(cs_ctx);
 
     /* Check if the context belongs to that group  */
-    if (ns_ctx_data[idx].gid != gid) {
-        __enable_irq();
+    if ((ns_ctx_data[idx].gid != gid) || (ns_ctx_data[idx].ref_cnt == 0)) {
+        CRITICAL_SECTION_LEAVE(cs_ctx);
         return false;
     }
 
@@ -110,9 +118,7 @@ bool release_ns_ctx(uint8_t gid, uint8_t tid, uint8_t idx)
     if (idx == active_ns_ctx_index) {
         if (ns_ctx_data[idx].tid == tid) {
             /* Release the currrent active thread */
-            if (ns_ctx_data[idx].ref_cnt > 0) {
-                ns_ctx_data[idx].ref_cnt--;
-            }
+            ns_ctx_data[idx].ref_cnt--;
             active_ns_ctx_index = TFM_NS_CONTEXT_MAX;
         } else {
             /*
@@ -126,43 +132,50 @@ bool release_ns_ctx(uint8_t gid, uint8_t tid, uint8_t idx)
         }
     } else {
         /* Release in the non-active context */
-        if (ns_ctx_data[idx].ref_cnt > 0) {
-            ns_ctx_data[idx].ref_cnt--;
-        }
+        ns_ctx_data[idx].ref_cnt--;
     }
 
-    __enable_irq();
+    /* The last thread of the group is gone, the context is free again */
+    if (ns_ctx_data[idx].ref_cnt == 0) {
+        free_ns_ctx(idx);
+    }
+
+    CRITICAL_SECTION_LEAVE(cs_ctx);
     return true;
 }
 
 bool load_ns_ctx(uint8_t gid, uint8_t tid, int32_t nsid, uint8_t idx)
 {
+    struct critical_section_t cs_ctx = CRITICAL_SECTION_STATIC_INIT;
+
     /* Check if the index is in range */
     if (idx >= TFM_NS_CONTEXT_MAX) {
         return false;
     }
 
-    __disable_irq();
+    CRITICAL_SECTION_ENTER(cs_ctx);
 
     /* Check group ID and reference counter */
     if ((ns_ctx_data[idx].gid != gid) || (ns_ctx_data[idx].ref_cnt == 0)) {
-        __enable_irq();
+        CRITICAL_SECTION_LEAVE(cs_ctx);
         return false;
     }
 
     ns_ctx_data[idx].tid = tid;
     ns_ctx_data[idx].nsid = nsid;
     active_ns_ctx_index = idx;
-    __enable_irq();
+    CRITICAL_SECTION_LEAVE(cs_ctx);
     return true;
 }
 
 bool save_ns_ctx(uint8_t gid, uint8_t tid, uint8_t idx)
 {
-    __disable_irq();
+    struct critical_section_t cs_ctx = CRITICAL_SECTION_STATIC_INIT;
+
+    CRITICAL_SECTION_ENTER(cs_ctx);
     /* Check if the given index is valid */
     if ((idx != active_ns_ctx_index) || (idx >= TFM_NS_CONTEXT_MAX)) {
-        __enable_irq();
+        CRITICAL_SECTION_LEAVE(cs_ctx);
         return false;
     }
 
@@ -170,26 +183,27 @@ bool save_ns_ctx(uint8_t gid, uint8_t tid, uint8_t idx)
     if ((ns_ctx_data[idx].gid != gid)
         || (ns_ctx_data[idx].tid != tid)
         || (ns_ctx_data[idx].ref_cnt == 0)) {
-        __enable_irq();
+        CRITICAL_SECTION_LEAVE(cs_ctx);
         return false;
     }
 
     /* Set active context index to invalid */
     active_ns_ctx_index = TFM_NS_CONTEXT_MAX;
-    __enable_irq();
+    CRITICAL_SECTION_LEAVE(cs_ctx);
     return true;
 }
 
 int32_t get_nsid_from_active_ns_ctx(void)
 {
+    struct critical_section_t cs_ctx = CRITICAL_SECTION_STATIC_INIT;
     int32_t ret = TFM_NS_CLIENT_INVALID_ID;
 
-    __disable_irq();
+    CRITICAL_SECTION_ENTER(cs_ctx);
 
     if (active_ns_ctx_index < TFM_NS_CONTEXT_MAX) {
         ret = ns_ctx_data[active_ns_ctx_index].nsid;
     }
 
-    __enable_irq();
+    CRITICAL_SECTION_LEAVE(cs_ctx);
     return ret;
 }
@@ -9,9 +9,17 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "config_tfm.h"
 
-/* Supported maximum context for NS. Only support single context for now. */
-#define TFM_NS_CONTEXT_MAX                  1
+/*
+ * Supported maximum context for NS. The context index is 8-bit in the client
+ * token and TFM_NS_CONTEXT_MAX itself marks an invalid index.
+ */
+#define TFM_NS_CONTEXT_MAX                  CONFIG_TFM_NS_CONTEXT_MAX_NUM
+
+#if (TFM_NS_CONTEXT_MAX < 1) || (TFM_NS_CONTEXT_MAX > 255)
+#error "CONFIG_TFM_NS_CONTEXT_MAX_NUM must be in the range of 1 to 255"
+#endif
 
 #define TFM_NS_CONTEXT_MAX_TID              0xFF
 
@@ -0,0 +1,141 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2023, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+"""
+Report the cold boot timeline recorded with CONFIG_TFM_BOOT_TIMELINE.
+
+Dump the shared boot data area with a debugger once the NSPE runs, for
+example in GDB:
+    dump binary memory boot_data.bin <BOOT_TFM_SHARED_DATA_BASE> <LIMIT + 1>
+
+A buffer filled by tfm_core_get_boot_data(TLV_MAJOR_BTL, ...) has the same
+format and can be reported too. Then run:
+    python3 boot_timeline_report.py boot_data.bin [--cpu-hz 100000000]
+
+Each checkpoint marks the beginning of a boot step, which lasts until the
+next checkpoint.
+"""
+
+import argparse
+import struct
+import sys
+
+# Keep in sync with secure_fw/spm/include/boot/tfm_boot_status.h
+SHARED_DATA_TLV_INFO_MAGIC = 0x2016
+TLV_MAJOR_BTL              = 0x4
+
+HEADER_FMT     = '<HH'
+ENTRY_FMT      = '<HH'
+CHECKPOINT_FMT = '<IHH'
+
+STAGES = {
+    0x0: 'BL1_1',
+    0x1: 'BL1_2',
+    0x2: 'BL2',
+    0x3: 'SPM',
+}
+
+CHECKPOINTS = {
+    0x0: 'start',
+    0x1: 'image copy',
+    0x2: 'image decrypt',
+    0x3: 'image hash',
+    0x4: 'signature verify',
+    0x5: 'image load',
+    0x6: 'partition load',
+    0x7: 'partition init',
+    0x8: 'jump',
+}
+
+CP_IMAGE_STEPS = (0x1, 0x2, 0x3, 0x4, 0x5)
+CP_PART_INIT   = 0x7
+
+def load_checkpoints(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    hdr_size = struct.calcsize(HEADER_FMT)
+    if len(data) < hdr_size:
+        sys.exit('Dump is too short')
+
+    magic, tot_len = struct.unpack_from(HEADER_FMT, data, 0)
+    if magic != SHARED_DATA_TLV_INFO_MAGIC:
+        sys.exit('Bad magic 0x{:04x}, not a shared boot data area'.format(magic))
+    if tot_len > len(data):
+        sys.exit('Dump is shorter than the {} bytes of TLVs'.format(tot_len))
+
+    checkpoints = []
+    offset = hdr_size
+    while offset + struct.calcsize(ENTRY_FMT) <= tot_len:
+        tlv_type, tlv_len = struct.unpack_from(ENTRY_FMT, data, offset)
+        offset += struct.calcsize(ENTRY_FMT)
+        if (tlv_type >> 12) == TLV_MAJOR_BTL and \
+           tlv_len == struct.calcsize(CHECKPOINT_FMT):
+            ts, cp, arg = struct.unpack_from(CHECKPOINT_FMT, data, offset)
+            stage = (tlv_type >> 8) & 0xF
+            seq = tlv_type & 0xFF
+            checkpoints.append((stage, seq, ts, cp, arg))
+        offset += tlv_len
+
+    # Stages run one after the other, the entries of a stage are in order
+    checkpoints.sort(key=lambda c: (c[0], c[1]))
+    return checkpoints
+
+def elapsed(start, end):
+    # The 32-bit counter may wrap during the boot
+    return (end - start) & 0xFFFFFFFF
+
+def fmt_time(ticks, cpu_hz):
+    if cpu_hz:
+        return '{:10.2f}us'.format(ticks * 1000000.0 / cpu_hz)
+    return '{:10d}'.format(ticks)
+
+def step_name(cp, arg):
+    name = CHECKPOINTS.get(cp, 'checkpoint {}'.format(cp))
+    if cp in CP_IMAGE_STEPS:
+        return '{} (image {})'.format(name, arg)
+    if cp == CP_PART_INIT:
+        return '{} (pid {})'.format(name, arg)
+    return name
+
+def print_timeline(checkpoints, cpu_hz):
+    base = checkpoints[0][2]
+    stage_total = {}
+
+    print('Boot timeline ({}):'.format('time' if cpu_hz else 'ticks'))
+    print('  {:<6} {:<32} {:>12} {:>12}'.format('stage', 'step', 'at', 'duration'))
+    for i, (stage, _, ts, cp, arg) in enumerate(checkpoints):
+        if i + 1 < len(checkpoints):
+            duration = elapsed(ts, checkpoints[i + 1][2])
+            stage_total[stage] = stage_total.get(stage, 0) + duration
+            duration = fmt_time(duration, cpu_hz)
+        else:
+            duration = '-'
+        print('  {:<6} {:<32} {:>12} {:>12}'.format(
+              STAGES.get(stage, str(stage)), step_name(cp, arg),
+              fmt_time(elapsed(base, ts), cpu_hz), duration))
+
+    print()
+    print('Per stage:')
+    for stage in sorted(stage_total):
+        print('  {:<6} {:>12}'.format(STAGES.get(stage, str(stage)),
+                                       fmt_time(stage_total[stage], cpu_hz)))
+    print('  {:<6} {:>12}'.format('total',
+          fmt_time(elapsed(base, checkpoints[-1][2]), cpu_hz)))
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Report the boot timeline')
+    parser.add_argument('dump', help='Binary dump of the shared boot data area')
+    parser.add_argument('--cpu-hz', type=int, default=0,
+                        help='Timestamp clock, to print times instead of ticks')
+    args = parser.parse_args()
+
+    checkpoints = load_checkpoints(args.dump)
+    if not checkpoints:
+        sys.exit('No boot timeline checkpoint found')
+
+    print_timeline(checkpoints, args.cpu_hz)
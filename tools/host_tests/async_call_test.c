@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Test of psa_call_async() and psa_get_reply() of the IPC backend.
+ *
+ * The SPM handlers of psa_call_async() and psa_get_reply() and the IPC
+ * backend are built for the host. The connection management, the memory
+ * checks and the client ID lookup are replaced below.
+ *
+ * A Secure Partition client sends several asynchronous requests to one
+ * service. The service takes the messages and replies to them out of order,
+ * sometimes while the client is collecting earlier replies. The replies must
+ * be collected in the order they were made, each with its own status, the
+ * reply signal must stay asserted until the last one is collected and each
+ * connection must be freed once. NS agents must be rejected.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "async.h"
+#include "critical_section.h"
+#include "current.h"
+#include "fih.h"
+#include "ffm/backend.h"
+#include "ffm/psa_api.h"
+#include "lists.h"
+#include "psa/service.h"
+#include "spm.h"
+#include "thread.h"
+#include "tfm_psa_call_pack.h"
+#include "utilities.h"
+
+#define NR_REQUESTS             4
+#define SERVICE_SID             0x100
+#define SERVICE_SIGNAL          0x10
+#define CLIENT_PID              0x100
+#define SERVICE_PID             0x101
+
+/* Stateless handle of the service */
+#define SERVICE_HANDLE          (psa_handle_t)((1UL <<                    \
+                                    STATIC_HANDLE_INDICATOR_OFFSET) |     \
+                                    SERVICE_SID)
+
+#define TEST_ASSERT(cond)                                               \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            printf("FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            exit(1);                                                    \
+        }                                                               \
+    } while (0)
+
+static struct partition_load_info_t client_ldinf = {
+    .pid   = CLIENT_PID,
+    .flags = PARTITION_MODEL_IPC | PARTITION_PRI_HIGH,
+};
+
+static struct partition_load_info_t service_pt_ldinf = {
+    .pid   = SERVICE_PID,
+    .flags = PARTITION_MODEL_IPC | PARTITION_PRI_LOW,
+};
+
+static struct service_load_info_t service_ldinf = {
+    .sid    = SERVICE_SID,
+    .signal = SERVICE_SIGNAL,
+};
+
+static struct partition_t client_pt;
+static struct partition_t service_pt;
+static struct service_t service;
+
+static struct connection_t connections[NR_REQUESTS];
+static uint32_t nr_allocated;
+static uint32_t nr_freed[NR_REQUESTS];
+
+/*************************** SPM replacements *********************************/
+
+psa_status_t spm_get_connection(struct connection_t **p_connection,
+                                psa_handle_t handle,
+                                int32_t client_id)
+{
+    struct connection_t *p_conn;
+
+    TEST_ASSERT(IS_STATIC_HANDLE(handle));
+    TEST_ASSERT(nr_allocated < NR_REQUESTS);
+
+    p_conn = &connections[nr_allocated++];
+    memset(p_conn, 0, sizeof(*p_conn));
+    p_conn->status = TFM_HANDLE_STATUS_IDLE;
+    p_conn->service = &service;
+    p_conn->p_client = GET_CURRENT_COMPONENT();
+    p_conn->msg.client_id = client_id;
+    p_conn->msg.handle = (psa_handle_t)nr_allocated;
+
+    *p_connection = p_conn;
+
+    return PSA_SUCCESS;
+}
+
+void spm_free_connection(struct connection_t *p_connection)
+{
+    nr_freed[p_connection - connections]++;
+}
+
+bool tfm_spm_is_ns_caller(void)
+{
+    return IS_NS_AGENT((GET_CURRENT_COMPONENT())->p_ldinf);
+}
+
+int32_t tfm_spm_get_client_id(bool ns_caller)
+{
+    TEST_ASSERT(!ns_caller);
+
+    return (GET_CURRENT_COMPONENT())->p_ldinf->pid;
+}
+
+FIH_RET_TYPE(enum tfm_hal_status_t) tfm_hal_memory_check(uintptr_t boundary,
+                                                         uintptr_t base,
+                                                         size_t size,
+                                                         uint32_t access_type)
+{
+    (void)boundary;
+    (void)access_type;
+
+    FIH_RET((base != 0) && (size != 0) ? fih_int_encode(TFM_HAL_SUCCESS) :
+                                         fih_int_encode(TFM_HAL_ERROR_GENERIC));
+}
+
+/******************************* Helpers **************************************/
+
+static void partition_init(struct partition_t *p_pt,
+                           const struct partition_load_info_t *p_ldinf)
+{
+    memset(p_pt, 0, sizeof(*p_pt));
+    p_pt->p_ldinf = p_ldinf;
+    THRD_INIT(&p_pt->thrd, &p_pt->ctx_ctrl,
+              TO_THREAD_PRIORITY(PARTITION_PRIORITY(p_ldinf->flags)));
+}
+
+static void run_as(struct partition_t *p_pt)
+{
+    CURRENT_THREAD = &p_pt->thrd;
+}
+
+/* As psa_get() of the service, the messages are delivered in order */
+static struct connection_t *service_get(void)
+{
+    struct connection_t *p_conn;
+
+    UNI_QUEUE_POP(service.p_msg_head, service.p_msg_tail, p_conn, p_handles);
+
+    return p_conn;
+}
+
+/* As psa_reply() of the service, for a stateless service */
+static void service_reply(struct connection_t *p_conn, psa_status_t status)
+{
+    struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
+
+    run_as(&service_pt);
+
+    p_conn->status = TFM_HANDLE_STATUS_TO_FREE;
+
+    CRITICAL_SECTION_ENTER(cs_assert);
+    (void)backend_replying(p_conn, status);
+    CRITICAL_SECTION_LEAVE(cs_assert);
+
+    run_as(&client_pt);
+}
+
+static void collect_reply(struct connection_t *p_conn, psa_status_t status,
+                          bool last)
+{
+    psa_handle_t request = PSA_NULL_HANDLE;
+
+    TEST_ASSERT(client_pt.signals_asserted & ASYNC_CALL_REPLY);
+    TEST_ASSERT(tfm_spm_client_psa_get_reply(&request) == status);
+    TEST_ASSERT(request == p_conn->msg.handle);
+    TEST_ASSERT(nr_freed[p_conn - connections] == 1);
+    TEST_ASSERT(!!(client_pt.signals_asserted & ASYNC_CALL_REPLY) == !last);
+}
+
+/******************************** Tests ***************************************/
+
+static void test_reply_order(void)
+{
+    struct connection_t *p_msgs[NR_REQUESTS];
+    psa_handle_t requests[NR_REQUESTS];
+    psa_handle_t request;
+    uint32_t ctrl_param = PARAM_PACK(0, 0, 0);
+    uint32_t i;
+
+    run_as(&client_pt);
+
+    for (i = 0; i < NR_REQUESTS; i++) {
+        requests[i] = tfm_spm_client_psa_call_async(SERVICE_HANDLE,
+                                                    ctrl_param, NULL, NULL);
+        TEST_ASSERT(requests[i] == (psa_handle_t)(i + 1));
+    }
+
+    /* The service is raised to the client priority until the last reply */
+    TEST_ASSERT(service_pt.signals_asserted & SERVICE_SIGNAL);
+    TEST_ASSERT(service_pt.thrd.priority == client_pt.thrd.priority);
+    TEST_ASSERT(!(client_pt.signals_asserted & ASYNC_CALL_REPLY));
+
+    for (i = 0; i < NR_REQUESTS; i++) {
+        p_msgs[i] = service_get();
+        TEST_ASSERT(p_msgs[i] == &connections[i]);
+    }
+    TEST_ASSERT(service_get() == NULL);
+
+    /* Replied as 2, 0, collected as 2, then replied as 3, 1 */
+    service_reply(p_msgs[2], 20);
+    service_reply(p_msgs[0], PSA_ERROR_INVALID_ARGUMENT);
+    TEST_ASSERT(nr_freed[2] == 0 && nr_freed[0] == 0);
+
+    collect_reply(p_msgs[2], 20, false);
+
+    service_reply(p_msgs[3], PSA_SUCCESS);
+    service_reply(p_msgs[1], 10);
+    TEST_ASSERT(service_pt.thrd.priority ==
+                TO_THREAD_PRIORITY(PARTITION_PRI_LOW));
+
+    collect_reply(p_msgs[0], PSA_ERROR_INVALID_ARGUMENT, false);
+    collect_reply(p_msgs[3], PSA_SUCCESS, false);
+    collect_reply(p_msgs[1], 10, true);
+
+    TEST_ASSERT(client_pt.p_handles == NULL);
+    TEST_ASSERT(client_pt.p_handles_tail == NULL);
+
+    /* Nothing is left to collect */
+    TEST_ASSERT(tfm_spm_client_psa_get_reply(&request) ==
+                PSA_ERROR_PROGRAMMER_ERROR);
+
+    /* A reply made after the queue emptied is collected too */
+    nr_allocated = 0;
+    memset(nr_freed, 0, sizeof(nr_freed));
+    requests[0] = tfm_spm_client_psa_call_async(SERVICE_HANDLE,
+                                                    ctrl_param, NULL, NULL);
+    TEST_ASSERT(requests[0] == 1);
+    service_reply(service_get(), 30);
+    collect_reply(&connections[0], 30, true);
+}
+
+static void test_ns_agent(void)
+{
+    static struct partition_load_info_t agent_ldinf = {
+        .pid   = 0x102,
+        .flags = PARTITION_MODEL_IPC | PARTITION_NS_AGENT_MB |
+                 PARTITION_PRI_LOW,
+    };
+    struct partition_t agent_pt;
+    psa_handle_t request;
+
+    partition_init(&agent_pt, &agent_ldinf);
+    run_as(&agent_pt);
+
+    nr_allocated = 0;
+    TEST_ASSERT(tfm_spm_client_psa_call_async(SERVICE_HANDLE,
+                                              PARAM_PACK(0, 0, 0),
+                                              NULL, NULL) ==
+                PSA_ERROR_PROGRAMMER_ERROR);
+    TEST_ASSERT(nr_allocated == 0);
+    TEST_ASSERT(tfm_spm_client_psa_get_reply(&request) ==
+                PSA_ERROR_PROGRAMMER_ERROR);
+}
+
+int main(void)
+{
+    partition_init(&client_pt, &client_ldinf);
+    partition_init(&service_pt, &service_pt_ldinf);
+    client_pt.signals_allowed = ASYNC_CALL_REPLY;
+    service_pt.signals_allowed = SERVICE_SIGNAL;
+
+    service.p_ldinf = &service_ldinf;
+    service.partition = &service_pt;
+
+    test_reply_order();
+    test_ns_agent();
+
+    printf("PASS\n");
+
+    return 0;
+}
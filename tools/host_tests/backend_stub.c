@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Host replacement of the SPM and platform symbols referenced by the IPC
+ * backend which the host tests do not exercise.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "fih.h"
+#include "load/partition_defs.h"
+#include "psa/error.h"
+#include "runtime_defs.h"
+#include "tfm_hal_isolation.h"
+
+/* Partition metadata pointer, not used on the host */
+uint32_t Image$$TFM_SP_META_PTR$$ZI$$Base;
+
+struct psa_api_tbl_t psa_api_thread_fn_call;
+
+/* Partition threads are simulated by the tests, they never run */
+void common_sfn_thread(void *param)
+{
+    (void)param;
+    abort();
+}
+
+void spm_handle_programmer_errors(psa_status_t status)
+{
+    (void)status;
+}
+
+FIH_RET_TYPE(enum tfm_hal_status_t) tfm_hal_activate_boundary(
+                             const struct partition_load_info_t *p_ldinf,
+                             uintptr_t boundary)
+{
+    (void)p_ldinf;
+    (void)boundary;
+
+    FIH_RET(fih_int_encode(TFM_HAL_SUCCESS));
+}
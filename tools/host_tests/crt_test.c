@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Correctness test and throughput benchmark of the TF-M CRT memory routines.
+ *
+ * The CRT sources are built for the host with their symbols renamed to
+ * crt_memcpy(), crt_memmove(), crt_memset() and crt_memcmp(), so they do not
+ * replace the host C library.
+ *
+ * The test runs each routine for all the source and destination offsets
+ * within two words, and for all the lengths up to a few bursts, then a few
+ * longer ones. The results are compared with a byte by byte reference, and
+ * the bytes around the destination must not change. memmove() is run on
+ * overlapping ranges in both directions.
+ *
+ * With '-b' the routines are timed against the host C library instead.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+void *crt_memcpy(void *dest, const void *src, size_t n);
+void *crt_memmove(void *dest, const void *src, size_t n);
+void *crt_memset(void *s, int c, size_t n);
+int crt_memcmp(const void *s1, const void *s2, size_t n);
+
+/* Offsets within two words, lengths over four bursts of four words */
+#define NR_OFFSETS              8
+#define MAX_SHORT_LEN           72
+#define GUARD_SIZE              16
+#define BUF_SIZE                (GUARD_SIZE + NR_OFFSETS + 1100 + GUARD_SIZE)
+#define GUARD_BYTE              0xA5
+
+#define BENCH_TOTAL_BYTES       (256UL * 1024 * 1024)
+
+#define TEST_ASSERT(cond)                                               \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            printf("FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            exit(1);                                                    \
+        }                                                               \
+    } while (0)
+
+/* Word aligned, as the CRT reads whole aligned words around the ranges */
+static uint32_t src_words[BUF_SIZE / sizeof(uint32_t) + 1];
+static uint32_t dst_words[BUF_SIZE / sizeof(uint32_t) + 1];
+static uint32_t ref_words[BUF_SIZE / sizeof(uint32_t) + 1];
+
+#define SRC_BUF                 ((uint8_t *)src_words)
+#define DST_BUF                 ((uint8_t *)dst_words)
+#define REF_BUF                 ((uint8_t *)ref_words)
+
+static const size_t long_lens[] = {
+    127, 128, 129, 255, 256, 257, 1021, 1024, 1027
+};
+
+static size_t nr_checks;
+
+static void fill_pattern(uint8_t *p, size_t n, uint8_t seed)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        /* Distinct neighbours, so a shifted copy never matches */
+        p[i] = (uint8_t)(seed + i * 7 + (i >> 8));
+    }
+}
+
+static void ref_move(uint8_t *dest, const uint8_t *src, size_t n)
+{
+    uint8_t tmp[BUF_SIZE];
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        tmp[i] = src[i];
+    }
+    for (i = 0; i < n; i++) {
+        dest[i] = tmp[i];
+    }
+}
+
+static void check_buf(const uint8_t *expected, const uint8_t *actual,
+                      const char *name, size_t soff, size_t doff, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < BUF_SIZE; i++) {
+        if (expected[i] != actual[i]) {
+            printf("FAIL: %s src offset %zu, dst offset %zu, length %zu: "
+                   "byte %zu is 0x%02x instead of 0x%02x\n",
+                   name, soff, doff, len, i, actual[i], expected[i]);
+            exit(1);
+        }
+    }
+
+    nr_checks++;
+}
+
+static void test_memcpy_len(size_t soff, size_t doff, size_t len)
+{
+    uint8_t *dst = DST_BUF + GUARD_SIZE + doff;
+    const uint8_t *src = SRC_BUF + GUARD_SIZE + soff;
+
+    memset(DST_BUF, GUARD_BYTE, BUF_SIZE);
+    memset(REF_BUF, GUARD_BYTE, BUF_SIZE);
+    ref_move(REF_BUF + GUARD_SIZE + doff, src, len);
+
+    TEST_ASSERT(crt_memcpy(dst, src, len) == dst);
+    check_buf(REF_BUF, DST_BUF, "memcpy", soff, doff, len);
+}
+
+static void test_memcpy(void)
+{
+    size_t soff, doff, len, i;
+
+    fill_pattern(SRC_BUF, BUF_SIZE, 1);
+
+    for (soff = 0; soff < NR_OFFSETS; soff++) {
+        for (doff = 0; doff < NR_OFFSETS; doff++) {
+            for (len = 0; len <= MAX_SHORT_LEN; len++) {
+                test_memcpy_len(soff, doff, len);
+            }
+            for (i = 0; i < sizeof(long_lens) / sizeof(long_lens[0]); i++) {
+                test_memcpy_len(soff, doff, long_lens[i]);
+            }
+        }
+    }
+}
+
+static void test_memset_len(size_t off, size_t len, int c)
+{
+    uint8_t *dst = DST_BUF + GUARD_SIZE + off;
+    size_t i;
+
+    memset(DST_BUF, GUARD_BYTE, BUF_SIZE);
+    memset(REF_BUF, GUARD_BYTE, BUF_SIZE);
+    for (i = 0; i < len; i++) {
+        REF_BUF[GUARD_SIZE + off + i] = (uint8_t)c;
+    }
+
+    TEST_ASSERT(crt_memset(dst, c, len) == dst);
+    check_buf(REF_BUF, DST_BUF, "memset", 0, off, len);
+}
+
+static void test_memset(void)
+{
+    /* Only the low byte of the value is stored */
+    static const int values[] = { 0x00, 0x5C, 0xFF, 0x180, -2 };
+    size_t off, len, i, v;
+
+    for (v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+        for (off = 0; off < NR_OFFSETS; off++) {
+            for (len = 0; len <= MAX_SHORT_LEN; len++) {
+                test_memset_len(off, len, values[v]);
+            }
+            for (i = 0; i < sizeof(long_lens) / sizeof(long_lens[0]); i++) {
+                test_memset_len(off, long_lens[i], values[v]);
+            }
+        }
+    }
+}
+
+/*
+ * Move inside one buffer. The source and destination offsets span three
+ * words, so the ranges overlap with the destination below, equal to or above
+ * the source, at every relative alignment.
+ */
+static void test_memmove_len(size_t soff, size_t doff, size_t len)
+{
+    uint8_t *dst = DST_BUF + GUARD_SIZE + doff;
+    uint8_t *src = DST_BUF + GUARD_SIZE + soff;
+
+    fill_pattern(DST_BUF, BUF_SIZE, 3);
+    fill_pattern(REF_BUF, BUF_SIZE, 3);
+    ref_move(REF_BUF + GUARD_SIZE + doff, REF_BUF + GUARD_SIZE + soff, len);
+
+    TEST_ASSERT(crt_memmove(dst, src, len) == dst);
+    check_buf(REF_BUF, DST_BUF, "memmove", soff, doff, len);
+}
+
+static void test_memmove(void)
+{
+    size_t soff, doff, len, i;
+
+    for (soff = 0; soff < NR_OFFSETS + 4; soff++) {
+        for (doff = 0; doff < NR_OFFSETS + 4; doff++) {
+            for (len = 0; len <= MAX_SHORT_LEN; len++) {
+                test_memmove_len(soff, doff, len);
+            }
+            for (i = 0; i < sizeof(long_lens) / sizeof(long_lens[0]); i++) {
+                test_memmove_len(soff, doff, long_lens[i]);
+            }
+        }
+    }
+}
+
+static int sign(int v)
+{
+    return (v > 0) - (v < 0);
+}
+
+static void test_memcmp(void)
+{
+    uint8_t *a = SRC_BUF + GUARD_SIZE;
+    uint8_t *b;
+    size_t aoff, boff, len, diff;
+    uint8_t saved;
+
+    for (aoff = 0; aoff < NR_OFFSETS; aoff++) {
+        for (boff = 0; boff < NR_OFFSETS; boff++) {
+            b = DST_BUF + GUARD_SIZE + boff;
+            for (len = 0; len <= MAX_SHORT_LEN; len++) {
+                fill_pattern(a + aoff, len, 5);
+                fill_pattern(b, len, 5);
+                TEST_ASSERT(crt_memcmp(a + aoff, b, len) == 0);
+
+                /*
+                 * A difference at each position, in both directions. The
+                 * bytes are compared as unsigned.
+                 */
+                for (diff = 0; diff < len; diff++) {
+                    saved = a[aoff + diff];
+                    a[aoff + diff] = 0x10;
+                    b[diff] = 0x90;
+                    TEST_ASSERT(sign(crt_memcmp(a + aoff, b, len)) ==
+                                sign(memcmp(a + aoff, b, len)));
+                    TEST_ASSERT(crt_memcmp(a + aoff, b, len) < 0);
+                    TEST_ASSERT(crt_memcmp(b, a + aoff, len) > 0);
+                    a[aoff + diff] = saved;
+                    b[diff] = saved;
+                    nr_checks++;
+                }
+            }
+        }
+    }
+}
+
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Keep the stores of the benchmarked calls */
+static volatile uint8_t bench_sink;
+
+static double bench_copy(void *(*fn)(void *, const void *, size_t),
+                         size_t soff, size_t doff, size_t len)
+{
+    size_t loops = BENCH_TOTAL_BYTES / len, i;
+    double start = now_sec();
+
+    for (i = 0; i < loops; i++) {
+        fn(DST_BUF + GUARD_SIZE + doff, SRC_BUF + GUARD_SIZE + soff, len);
+        bench_sink = DST_BUF[GUARD_SIZE + doff];
+    }
+
+    return (loops * len) / (now_sec() - start) / (1024 * 1024);
+}
+
+static double bench_set(void *(*fn)(void *, int, size_t), size_t off,
+                        size_t len)
+{
+    size_t loops = BENCH_TOTAL_BYTES / len, i;
+    double start = now_sec();
+
+    for (i = 0; i < loops; i++) {
+        fn(DST_BUF + GUARD_SIZE + off, (int)i, len);
+        bench_sink = DST_BUF[GUARD_SIZE + off];
+    }
+
+    return (loops * len) / (now_sec() - start) / (1024 * 1024);
+}
+
+static void run_bench(void)
+{
+    static const size_t lens[] = { 16, 64, 256, 1024 };
+    /* Aligned, destination unaligned and source unaligned */
+    static const size_t offs[][2] = { { 0, 0 }, { 1, 1 }, { 0, 1 }, { 3, 0 } };
+    size_t l, o;
+
+    printf("%-8s %5s %4s %4s %12s %12s\n",
+           "routine", "len", "soff", "doff", "crt MiB/s", "libc MiB/s");
+
+    for (l = 0; l < sizeof(lens) / sizeof(lens[0]); l++) {
+        for (o = 0; o < sizeof(offs) / sizeof(offs[0]); o++) {
+            printf("%-8s %5zu %4zu %4zu %12.0f %12.0f\n", "memcpy", lens[l],
+                   offs[o][0], offs[o][1],
+                   bench_copy(crt_memcpy, offs[o][0], offs[o][1], lens[l]),
+                   bench_copy(memcpy, offs[o][0], offs[o][1], lens[l]));
+        }
+        for (o = 0; o < sizeof(offs) / sizeof(offs[0]); o++) {
+            printf("%-8s %5zu %4zu %4zu %12.0f %12.0f\n", "memmove", lens[l],
+                   offs[o][0], offs[o][1],
+                   bench_copy(crt_memmove, offs[o][0], offs[o][1], lens[l]),
+                   bench_copy(memmove, offs[o][0], offs[o][1], lens[l]));
+        }
+        for (o = 0; o < 2; o++) {
+            printf("%-8s %5zu %4s %4zu %12.0f %12.0f\n", "memset", lens[l],
+                   "-", o, bench_set(crt_memset, o, lens[l]),
+                   bench_set(memset, o, lens[l]));
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if ((argc > 1) && (strcmp(argv[1], "-b") == 0)) {
+        run_bench();
+        return 0;
+    }
+
+    test_memcpy();
+    test_memset();
+    test_memmove();
+    test_memcmp();
+
+    printf("PASS: %zu checks\n", nr_checks);
+
+    return 0;
+}
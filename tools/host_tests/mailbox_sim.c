@@ -0,0 +1,729 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Dual-core mailbox simulator.
+ *
+ * The NSPE and SPE mailbox libraries run unmodified on host threads:
+ *  - Client threads issue psa_call() through tfm_ns_mailbox_client_call().
+ *  - With TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD, NS mailbox threads run
+ *    tfm_ns_mailbox_thread_runner().
+ *  - A NS IRQ thread stands for the mailbox interrupt handler of NSPE and
+ *    calls tfm_ns_mailbox_wake_reply_owner_isr().
+ *  - A SPE thread stands for the secure core. It calls
+ *    tfm_mailbox_handle_msg() when NSPE notifies it and runs the stub RoT
+ *    services one at a time, each taking its configured latency before the
+ *    reply is returned through the RPC reply() callback.
+ *
+ * The notifications between the cores only set a pending flag, as an
+ * interrupt does. The simulator reports the requests per second, the p50 and
+ * p99 latencies of the calls and the notification counts of both sides.
+ *
+ * Once the clients are done, a psa_call_batch() of the multi-core NS API
+ * sends one request to each service and one to an invalid handle. Each
+ * request must get its own status.
+ *
+ * With '-f' the message queue of the NS mailbox threads fails to send when it
+ * is full, as a non-blocking OS queue does, and the clients retry the calls
+ * which are rejected.
+ *
+ * Usage: mailbox_sim [-c clients] [-n calls per client] [-s latency_us,...]
+ *                    [-f]
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "psa/client.h"
+#include "tfm_ns_mailbox.h"
+#include "tfm_ns_mailbox_test.h"
+#include "tfm_psa_call_batch.h"
+#include "tfm_psa_call_pack.h"
+#include "tfm_rpc.h"
+#include "tfm_spe_mailbox.h"
+
+#define SIM_MAX_CLIENTS             64
+#define SIM_MAX_SERVICES            8
+
+#define SIM_DEFAULT_CLIENTS         4
+#define SIM_DEFAULT_CALLS           2000
+
+#define SIM_ASSERT(cond)                                                \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            printf("FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            exit(1);                                                    \
+        }                                                               \
+    } while (0)
+
+/* An event flag, as the thread flags or a pending interrupt */
+struct sim_event_t {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    bool            is_set;
+};
+
+#define SIM_EVENT_INIT  {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, \
+                         false}
+
+/* A NS task, the handle returned by tfm_ns_mailbox_os_get_task_handle() */
+struct sim_task_t {
+    struct sim_event_t  wake;
+};
+
+/* A stub RoT service call in progress in SPE */
+struct sim_job_t {
+    const void *owner;
+    int32_t    ret;
+    uint32_t   latency_us;
+};
+
+struct sim_client_t {
+    pthread_t         thread;
+    uint32_t          id;
+    uint64_t          *latency_ns;
+};
+
+/* Shared memory between the cores */
+static struct ns_mailbox_queue_t ns_queue;
+
+/* The lock between the cores, taken by tfm_*mailbox_hal_enter_critical() */
+static pthread_mutex_t xcore_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Masking the interrupts in NSPE */
+static pthread_mutex_t ns_irq_lock;
+
+static struct sim_event_t spe_irq = SIM_EVENT_INIT;
+static struct sim_event_t ns_irq = SIM_EVENT_INIT;
+
+static volatile bool sim_done;
+static uint32_t nr_spe_irq, nr_ns_irq;
+
+/* Configuration */
+static uint32_t nr_clients = SIM_DEFAULT_CLIENTS;
+static uint32_t nr_calls = SIM_DEFAULT_CALLS;
+static bool mq_fail_when_full;
+static uint32_t service_latency_us[SIM_MAX_SERVICES] = {0};
+static uint32_t nr_services = 1;
+
+static __thread struct sim_task_t *curr_task;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void sim_event_init(struct sim_event_t *evt)
+{
+    pthread_mutex_init(&evt->lock, NULL);
+    pthread_cond_init(&evt->cond, NULL);
+    evt->is_set = false;
+}
+
+static void sim_event_set(struct sim_event_t *evt)
+{
+    pthread_mutex_lock(&evt->lock);
+    evt->is_set = true;
+    pthread_cond_signal(&evt->cond);
+    pthread_mutex_unlock(&evt->lock);
+}
+
+/* Returns false if the event is not set in timeout_us */
+static bool sim_event_wait(struct sim_event_t *evt, uint32_t timeout_us)
+{
+    struct timespec ts;
+    bool is_set;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_nsec += (long)timeout_us * 1000;
+    ts.tv_sec += ts.tv_nsec / 1000000000;
+    ts.tv_nsec %= 1000000000;
+
+    pthread_mutex_lock(&evt->lock);
+    while (!evt->is_set) {
+        if (pthread_cond_timedwait(&evt->cond, &evt->lock, &ts) != 0) {
+            break;
+        }
+    }
+    is_set = evt->is_set;
+    evt->is_set = false;
+    pthread_mutex_unlock(&evt->lock);
+
+    return is_set;
+}
+
+static void busy_wait_us(uint32_t us)
+{
+    uint64_t end = now_ns() + (uint64_t)us * 1000;
+
+    while (now_ns() < end) {
+    }
+}
+
+static struct sim_task_t *get_curr_task(void)
+{
+    if (!curr_task) {
+        curr_task = malloc(sizeof(*curr_task));
+        SIM_ASSERT(curr_task != NULL);
+        sim_event_init(&curr_task->wake);
+    }
+
+    return curr_task;
+}
+
+/* ----------------------------- NSPE HAL ---------------------------------- */
+
+int32_t tfm_ns_mailbox_hal_init(struct ns_mailbox_queue_t *queue)
+{
+    (void)queue;
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_ns_mailbox_hal_notify_peer(void)
+{
+    sim_event_set(&spe_irq);
+
+    return MAILBOX_SUCCESS;
+}
+
+void tfm_ns_mailbox_hal_enter_critical(void)
+{
+    pthread_mutex_lock(&ns_irq_lock);
+    pthread_mutex_lock(&xcore_lock);
+}
+
+void tfm_ns_mailbox_hal_exit_critical(void)
+{
+    pthread_mutex_unlock(&xcore_lock);
+    pthread_mutex_unlock(&ns_irq_lock);
+}
+
+void tfm_ns_mailbox_hal_enter_critical_isr(void)
+{
+    pthread_mutex_lock(&xcore_lock);
+}
+
+void tfm_ns_mailbox_hal_exit_critical_isr(void)
+{
+    pthread_mutex_unlock(&xcore_lock);
+}
+
+/* ------------------------------ NSPE OS ---------------------------------- */
+
+/* The mailbox queue slots free for the calls */
+static pthread_mutex_t slot_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t slot_cond = PTHREAD_COND_INITIALIZER;
+static uint32_t nr_free_slots;
+
+int32_t tfm_ns_mailbox_os_lock_init(void)
+{
+    nr_free_slots = NUM_MAILBOX_QUEUE_SLOT;
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_ns_mailbox_os_lock_acquire(void)
+{
+    pthread_mutex_lock(&slot_lock);
+    while (nr_free_slots == 0) {
+        pthread_cond_wait(&slot_cond, &slot_lock);
+    }
+    nr_free_slots--;
+    pthread_mutex_unlock(&slot_lock);
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_ns_mailbox_os_lock_release(void)
+{
+    pthread_mutex_lock(&slot_lock);
+    nr_free_slots++;
+    pthread_cond_signal(&slot_cond);
+    pthread_mutex_unlock(&slot_lock);
+
+    return MAILBOX_SUCCESS;
+}
+
+const void *tfm_ns_mailbox_os_get_task_handle(void)
+{
+    return get_curr_task();
+}
+
+void tfm_ns_mailbox_os_wait_reply(void)
+{
+    struct sim_task_t *task = get_curr_task();
+
+    while (!sim_event_wait(&task->wake, 100000)) {
+    }
+}
+
+void tfm_ns_mailbox_os_wake_task_isr(const void *task_handle)
+{
+    struct sim_task_t *task = (struct sim_task_t *)task_handle;
+
+    if (task) {
+        sim_event_set(&task->wake);
+    }
+}
+
+void tfm_ns_mailbox_os_spin_lock(void)
+{
+    pthread_mutex_lock(&ns_irq_lock);
+}
+
+void tfm_ns_mailbox_os_spin_unlock(void)
+{
+    pthread_mutex_unlock(&ns_irq_lock);
+}
+
+/* A blocking FIFO of fixed size messages */
+struct sim_mq_t {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    size_t          msg_size;
+    uint32_t        depth;
+    uint32_t        head;
+    uint32_t        tail;
+    uint8_t         *buf;
+};
+
+void *tfm_ns_mailbox_os_mq_create(size_t msg_size, uint8_t msg_count)
+{
+    struct sim_mq_t *mq = calloc(1, sizeof(*mq));
+
+    if (!mq) {
+        return NULL;
+    }
+
+    pthread_mutex_init(&mq->lock, NULL);
+    pthread_cond_init(&mq->cond, NULL);
+    mq->msg_size = msg_size;
+    mq->depth = msg_count;
+    mq->buf = calloc(msg_count, msg_size);
+    if (!mq->buf) {
+        free(mq);
+        return NULL;
+    }
+
+    return mq;
+}
+
+int32_t tfm_ns_mailbox_os_mq_send(void *mq_handle, const void *msg_ptr)
+{
+    struct sim_mq_t *mq = mq_handle;
+
+    pthread_mutex_lock(&mq->lock);
+    while (mq->head - mq->tail == mq->depth) {
+        if (mq_fail_when_full) {
+            pthread_mutex_unlock(&mq->lock);
+            return MAILBOX_QUEUE_FULL;
+        }
+        pthread_cond_wait(&mq->cond, &mq->lock);
+    }
+    memcpy(&mq->buf[(mq->head % mq->depth) * mq->msg_size], msg_ptr,
+           mq->msg_size);
+    mq->head++;
+    pthread_cond_broadcast(&mq->cond);
+    pthread_mutex_unlock(&mq->lock);
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_ns_mailbox_os_mq_receive(void *mq_handle, void *msg_ptr)
+{
+    struct sim_mq_t *mq = mq_handle;
+
+    pthread_mutex_lock(&mq->lock);
+    while (mq->head == mq->tail) {
+        pthread_cond_wait(&mq->cond, &mq->lock);
+    }
+    memcpy(msg_ptr, &mq->buf[(mq->tail % mq->depth) * mq->msg_size],
+           mq->msg_size);
+    mq->tail++;
+    pthread_cond_broadcast(&mq->cond);
+    pthread_mutex_unlock(&mq->lock);
+
+    return MAILBOX_SUCCESS;
+}
+
+/* -------------------------- NSPE statistics ------------------------------ */
+
+void tfm_ns_mailbox_tx_stats_init(struct ns_mailbox_queue_t *queue)
+{
+    queue->nr_tx = 0;
+    queue->nr_used_slots = 0;
+}
+
+int32_t tfm_ns_mailbox_tx_stats_reinit(void)
+{
+    tfm_ns_mailbox_tx_stats_init(&ns_queue);
+
+    return MAILBOX_SUCCESS;
+}
+
+void tfm_ns_mailbox_tx_stats_update(void)
+{
+    __atomic_fetch_add(&ns_queue.nr_tx, 1, __ATOMIC_RELAXED);
+}
+
+/* ------------------------------ SPE HAL ---------------------------------- */
+
+int32_t tfm_mailbox_hal_init(struct secure_mailbox_queue_t *s_queue)
+{
+    s_queue->ns_queue = &ns_queue;
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_mailbox_hal_notify_peer(void)
+{
+    sim_event_set(&ns_irq);
+
+    return MAILBOX_SUCCESS;
+}
+
+void tfm_mailbox_hal_enter_critical(void)
+{
+    pthread_mutex_lock(&xcore_lock);
+}
+
+void tfm_mailbox_hal_exit_critical(void)
+{
+    pthread_mutex_unlock(&xcore_lock);
+}
+
+/* ------------------------------ SPE RPC ---------------------------------- */
+
+static const struct tfm_rpc_ops_t *rpc_ops;
+
+/* The service calls accepted by SPE, served in order */
+static struct sim_job_t jobs[NUM_MAILBOX_QUEUE_SLOT];
+static uint32_t job_head, job_tail;
+
+int32_t tfm_rpc_register_ops(const struct tfm_rpc_ops_t *ops_ptr)
+{
+    if (!ops_ptr || !ops_ptr->handle_req || !ops_ptr->reply ||
+        !ops_ptr->get_caller_data) {
+        return TFM_RPC_INVAL_PARAM;
+    }
+
+    if (rpc_ops) {
+        return TFM_RPC_CONFLICT_CALLBACK;
+    }
+
+    rpc_ops = ops_ptr;
+
+    return TFM_RPC_SUCCESS;
+}
+
+void tfm_rpc_unregister_ops(void)
+{
+    rpc_ops = NULL;
+}
+
+uint32_t tfm_rpc_psa_framework_version(void)
+{
+    return PSA_FRAMEWORK_VERSION;
+}
+
+uint32_t tfm_rpc_psa_version(uint32_t sid)
+{
+    (void)sid;
+
+    return PSA_VERSION_NONE;
+}
+
+/*
+ * The stub service of a handle replies the call type, so that the clients
+ * check that they get the result of their own call.
+ */
+psa_status_t tfm_rpc_psa_call(psa_handle_t handle, uint32_t control,
+                              const struct client_params_t *params,
+                              const void *client_data_stateless)
+{
+    struct sim_job_t *job;
+
+    (void)client_data_stateless;
+
+    if ((handle <= 0) || ((uint32_t)handle > nr_services)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /* SPE takes a single call per mailbox queue slot */
+    SIM_ASSERT(job_head - job_tail < NUM_MAILBOX_QUEUE_SLOT);
+
+    job = &jobs[job_head % NUM_MAILBOX_QUEUE_SLOT];
+    job->owner = rpc_ops->get_caller_data(params->ns_client_id_stateless);
+    job->ret = (int32_t)(control & TYPE_MASK);
+    job->latency_us = service_latency_us[handle - 1];
+    job_head++;
+
+    return PSA_SUCCESS;
+}
+
+static void *spe_core(void *arg)
+{
+    struct sim_job_t *job;
+
+    (void)arg;
+
+    while (!sim_done) {
+        /* Run the pending service call, or sleep until a notification */
+        if (sim_event_wait(&spe_irq, (job_head == job_tail) ? 1000 : 0)) {
+            nr_spe_irq++;
+            rpc_ops->handle_req();
+        }
+
+        if (job_head == job_tail) {
+            continue;
+        }
+
+        job = &jobs[job_tail % NUM_MAILBOX_QUEUE_SLOT];
+        busy_wait_us(job->latency_us);
+        job_tail++;
+
+        rpc_ops->reply(job->owner, job->ret);
+    }
+
+    return NULL;
+}
+
+/* ------------------------------ NSPE IRQ --------------------------------- */
+
+static void *ns_irq_handler(void *arg)
+{
+    (void)arg;
+
+    while (!sim_done) {
+        if (!sim_event_wait(&ns_irq, 1000)) {
+            continue;
+        }
+
+        nr_ns_irq++;
+
+        pthread_mutex_lock(&ns_irq_lock);
+        (void)tfm_ns_mailbox_wake_reply_owner_isr();
+        pthread_mutex_unlock(&ns_irq_lock);
+    }
+
+    return NULL;
+}
+
+#ifdef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+static void *ns_mailbox_runner(void *arg)
+{
+    tfm_ns_mailbox_thread_runner(arg);
+
+    return NULL;
+}
+#endif
+
+/* ------------------------------- Clients --------------------------------- */
+
+static void *client(void *arg)
+{
+    struct sim_client_t *p_client = arg;
+    struct psa_client_params_t params;
+    int32_t reply, ret;
+    int32_t type;
+    uint64_t start;
+    uint32_t i;
+
+    memset(&params, 0, sizeof(params));
+    params.psa_call_params.handle = (psa_handle_t)(p_client->id %
+                                                   nr_services + 1);
+
+    for (i = 0; i < nr_calls; i++) {
+        type = (int32_t)((p_client->id * nr_calls + i) & 0x7FFF);
+        params.psa_call_params.type = type;
+        reply = -1;
+
+        start = now_ns();
+        do {
+            ret = tfm_ns_mailbox_client_call(MAILBOX_PSA_CALL, &params,
+                                             -(int32_t)(p_client->id + 1),
+                                             &reply);
+        } while (mq_fail_when_full && (ret == MAILBOX_QUEUE_FULL));
+        SIM_ASSERT(ret == MAILBOX_SUCCESS);
+        p_client->latency_ns[i] = now_ns() - start;
+
+        SIM_ASSERT(reply == type);
+    }
+
+    return NULL;
+}
+
+/* One request per service, then one to a handle no service has */
+static void test_call_batch(void)
+{
+    psa_call_desc_t calls[SIM_MAX_SERVICES + 1];
+    uint32_t i;
+
+    memset(calls, 0, sizeof(calls));
+    for (i = 0; i <= nr_services; i++) {
+        calls[i].handle = (psa_handle_t)(i + 1);
+        calls[i].type = (int32_t)(0x100 + i);
+        calls[i].status = -1;
+    }
+
+    SIM_ASSERT(psa_call_batch(calls, nr_services + 1) ==
+               PSA_ERROR_PROGRAMMER_ERROR);
+
+    for (i = 0; i < nr_services; i++) {
+        SIM_ASSERT(calls[i].status == calls[i].type);
+    }
+    SIM_ASSERT(calls[nr_services].status == PSA_ERROR_PROGRAMMER_ERROR);
+
+    SIM_ASSERT(psa_call_batch(calls, 0) == PSA_SUCCESS);
+    SIM_ASSERT(psa_call_batch(NULL, 1) == PSA_ERROR_PROGRAMMER_ERROR);
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void parse_args(int argc, char *argv[])
+{
+    char *tok;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:n:s:f")) != -1) {
+        switch (opt) {
+        case 'c':
+            nr_clients = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            nr_calls = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            nr_services = 0;
+            for (tok = strtok(optarg, ","); tok && nr_services <
+                 SIM_MAX_SERVICES; tok = strtok(NULL, ",")) {
+                service_latency_us[nr_services++] =
+                                        (uint32_t)strtoul(tok, NULL, 0);
+            }
+            break;
+        case 'f':
+            mq_fail_when_full = true;
+            break;
+        default:
+            printf("Usage: %s [-c clients] [-n calls per client] "
+                   "[-s latency_us,...] [-f]\n", argv[0]);
+            exit(2);
+        }
+    }
+
+    SIM_ASSERT((nr_clients > 0) && (nr_clients <= SIM_MAX_CLIENTS));
+    SIM_ASSERT((nr_calls > 0) && (nr_services > 0));
+}
+
+int main(int argc, char *argv[])
+{
+    static struct sim_client_t clients[SIM_MAX_CLIENTS];
+    pthread_mutexattr_t attr;
+    pthread_t spe, irq;
+    uint64_t *latency_ns, start, elapsed_ns;
+    uint32_t i, nr_total;
+
+    parse_args(argc, argv);
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&ns_irq_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    nr_total = nr_clients * nr_calls;
+    latency_ns = calloc(nr_total, sizeof(*latency_ns));
+    SIM_ASSERT(latency_ns != NULL);
+
+    SIM_ASSERT(tfm_ns_mailbox_init(&ns_queue) == MAILBOX_SUCCESS);
+    SIM_ASSERT(tfm_mailbox_init() == MAILBOX_SUCCESS);
+
+    SIM_ASSERT(pthread_create(&spe, NULL, spe_core, NULL) == 0);
+    SIM_ASSERT(pthread_create(&irq, NULL, ns_irq_handler, NULL) == 0);
+
+#ifdef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+    for (i = 0; i < TFM_MULTI_CORE_NS_MAILBOX_RUNNER_NUM; i++) {
+        pthread_t runner;
+
+        SIM_ASSERT(pthread_create(&runner, NULL, ns_mailbox_runner,
+                                  NULL) == 0);
+        pthread_detach(runner);
+    }
+#endif
+
+    start = now_ns();
+
+    for (i = 0; i < nr_clients; i++) {
+        clients[i].id = i;
+        clients[i].latency_ns = &latency_ns[i * nr_calls];
+        SIM_ASSERT(pthread_create(&clients[i].thread, NULL, client,
+                                  &clients[i]) == 0);
+    }
+
+    for (i = 0; i < nr_clients; i++) {
+        pthread_join(clients[i].thread, NULL);
+    }
+
+    elapsed_ns = now_ns() - start;
+
+    test_call_batch();
+
+    sim_done = true;
+    pthread_join(spe, NULL);
+    pthread_join(irq, NULL);
+
+    qsort(latency_ns, nr_total, sizeof(*latency_ns), cmp_u64);
+
+    printf("Mailbox: %u slots, %s transport", NUM_MAILBOX_QUEUE_SLOT,
+#ifdef MAILBOX_RING_TRANSPORT
+           "ring"
+#else
+           "bitmask"
+#endif
+          );
+#ifdef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+    printf(", %u NS mailbox threads", TFM_MULTI_CORE_NS_MAILBOX_RUNNER_NUM);
+#endif
+    printf("\nClients: %u, calls: %u, services:", nr_clients, nr_total);
+    for (i = 0; i < nr_services; i++) {
+        printf(" %uus", service_latency_us[i]);
+    }
+    printf("\n");
+
+    printf("Throughput:         %.0f requests/s\n",
+           (double)nr_total * 1e9 / (double)elapsed_ns);
+    printf("Latency p50:        %.1f us\n",
+           (double)latency_ns[nr_total / 2] / 1000.0);
+    printf("Latency p99:        %.1f us\n",
+           (double)latency_ns[(uint64_t)nr_total * 99 / 100] / 1000.0);
+    printf("NSPE to SPE:        %u notifications, %u SPE IRQs\n",
+           ns_queue.nr_req_notify, nr_spe_irq);
+    printf("SPE to NSPE:        %u notifications, %u NSPE IRQs handled\n",
+           ns_queue.nr_reply_notify, ns_queue.nr_reply_irq);
+
+    SIM_ASSERT(ns_queue.nr_tx == nr_total + nr_services + 1);
+    SIM_ASSERT(ns_queue.nr_reply_irq == nr_ns_irq);
+
+    free(latency_ns);
+
+    return 0;
+}
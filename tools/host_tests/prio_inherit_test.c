@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Priority inversion latency test for the SPM scheduler.
+ *
+ * The IPC backend and the scheduler are built for the host. Partition threads
+ * are simulated in ticks: each tick the thread returned by thrd_next() runs
+ * one unit of work. Messages are sent with backend_messaging() and replied
+ * with backend_replying() in a critical section, as psa_call() and
+ * psa_reply() do.
+ *
+ * A high priority client sends a request to a low priority service while
+ * medium priority partitions are runnable. The client latency is the number
+ * of ticks between the request and the client being scheduled again. With
+ * priority inheritance it is bounded by the service work, and the medium
+ * partitions only run after the client.
+ *
+ * A second part sends and replies messages while another host thread,
+ * standing for the interrupt handlers, asserts and takes signals of the
+ * medium partitions. The run queues must stay consistent.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "async.h"
+#include "critical_section.h"
+#include "current.h"
+#include "ffm/backend.h"
+#include "internal_status_code.h"
+#include "lists.h"
+#include "spm.h"
+#include "thread.h"
+#include "utilities.h"
+
+#define NR_MEDIUM_PTS           4
+#define SERVICE_WORK            10
+#define MEDIUM_WORK             25
+#define NR_STRESS_LOOPS         200000
+
+#define SERVICE_SIGNAL          0x10
+#define MEDIUM_SIGNAL           0x20
+
+#define TEST_ASSERT(cond)                                               \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            printf("FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            exit(1);                                                    \
+        }                                                               \
+    } while (0)
+
+struct sim_partition_t {
+    struct partition_t              pt;
+    struct partition_load_info_t    ldinf;
+    uint32_t                        work;
+};
+
+static struct sim_partition_t client;
+static struct sim_partition_t server;
+static struct sim_partition_t medium[NR_MEDIUM_PTS];
+
+static struct service_load_info_t service_ldinf = {
+    .sid    = 0x100,
+    .signal = SERVICE_SIGNAL,
+};
+static struct service_t service;
+static struct connection_t connection;
+
+static void sim_partition_init(struct sim_partition_t *p_sim, int32_t pid,
+                               uint32_t prio, psa_signal_t signal)
+{
+    memset(p_sim, 0, sizeof(*p_sim));
+    p_sim->ldinf.pid = pid;
+    p_sim->ldinf.flags = PARTITION_MODEL_IPC | prio;
+    p_sim->pt.p_ldinf = &p_sim->ldinf;
+    p_sim->pt.signals_allowed = signal;
+    THRD_INIT(&p_sim->pt.thrd, &p_sim->pt.ctx_ctrl, TO_THREAD_PRIORITY(prio));
+}
+
+static struct sim_partition_t *to_sim(struct thread_t *p_thrd)
+{
+    return (struct sim_partition_t *)GET_THRD_OWNER(p_thrd);
+}
+
+/* psa_wait() of a partition, blocked until one of the signals arrives */
+static void sim_wait(struct sim_partition_t *p_sim, psa_signal_t signals)
+{
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+
+    CRITICAL_SECTION_ENTER(cs);
+    p_sim->pt.signals_asserted &= ~signals;
+    (void)backend_wait_signals(&p_sim->pt, signals);
+    CRITICAL_SECTION_LEAVE(cs);
+}
+
+static void sim_assert(struct sim_partition_t *p_sim, psa_signal_t signal)
+{
+    (void)backend_assert_signal(&p_sim->pt, signal);
+}
+
+/* psa_call() of the client, which is left waiting for the reply */
+static void client_call(void)
+{
+    memset(&connection, 0, sizeof(connection));
+    connection.service = &service;
+    connection.p_client = &client.pt;
+
+    TEST_ASSERT(backend_messaging(&connection) == STATUS_NEED_SCHEDULE);
+}
+
+/* psa_get() of the service */
+static void service_get(void)
+{
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+    struct connection_t *p_conn;
+
+    CRITICAL_SECTION_ENTER(cs);
+    UNI_QUEUE_POP(service.p_msg_head, service.p_msg_tail, p_conn, p_handles);
+    server.pt.signals_asserted &= ~SERVICE_SIGNAL;
+    CRITICAL_SECTION_LEAVE(cs);
+
+    TEST_ASSERT(p_conn == &connection);
+}
+
+/* psa_reply() of the service, which then waits for the next message */
+static void service_reply(void)
+{
+    struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
+
+    CRITICAL_SECTION_ENTER(cs_assert);
+    (void)backend_replying(&connection, PSA_SUCCESS);
+    CRITICAL_SECTION_LEAVE(cs_assert);
+
+    sim_wait(&server, SERVICE_SIGNAL);
+}
+
+static void setup(void)
+{
+    uint32_t i;
+
+    sim_partition_init(&client, 1, PARTITION_PRI_HIGH, 0);
+    sim_partition_init(&server, 2, PARTITION_PRI_LOW, SERVICE_SIGNAL);
+    for (i = 0; i < NR_MEDIUM_PTS; i++) {
+        sim_partition_init(&medium[i], 3 + i, PARTITION_PRI_NORMAL,
+                           MEDIUM_SIGNAL);
+    }
+
+    service.p_ldinf = &service_ldinf;
+    service.partition = &server.pt;
+
+    /* The service and the medium partitions wait for their signals */
+    sim_wait(&server, SERVICE_SIGNAL);
+    for (i = 0; i < NR_MEDIUM_PTS; i++) {
+        sim_wait(&medium[i], MEDIUM_SIGNAL);
+    }
+}
+
+/*
+ * Run one request from the client to the service and return the number of
+ * ticks until the client runs again.
+ */
+static uint32_t run_request(void)
+{
+    struct thread_t *p_next;
+    uint32_t tick, i;
+
+    client_call();
+    TEST_ASSERT(server.pt.thrd.priority == client.pt.thrd.priority);
+
+    /* The service starts, then the medium partitions get their signals. */
+    p_next = thrd_next();
+    TEST_ASSERT(p_next == &server.pt.thrd);
+    service_get();
+    server.work = SERVICE_WORK - 1;
+    for (i = 0; i < NR_MEDIUM_PTS; i++) {
+        medium[i].work = MEDIUM_WORK;
+        sim_assert(&medium[i], MEDIUM_SIGNAL);
+    }
+
+    for (tick = 1; ; tick++) {
+        p_next = thrd_next();
+        TEST_ASSERT(p_next != NULL);
+
+        if (p_next == &client.pt.thrd) {
+            break;
+        }
+
+        /* The medium partitions must not delay the client */
+        TEST_ASSERT(p_next == &server.pt.thrd);
+
+        if (--server.work == 0) {
+            service_reply();
+        }
+    }
+
+    TEST_ASSERT(server.pt.thrd.priority ==
+                TO_THREAD_PRIORITY(PARTITION_PRI_LOW));
+    TEST_ASSERT(server.pt.n_prio_inherited == 0);
+
+    /* Then the medium partitions run once the client waits again */
+    sim_wait(&client, ASYNC_CALL_REPLY);
+    for (i = 0; i < NR_MEDIUM_PTS; i++) {
+        p_next = thrd_next();
+        TEST_ASSERT(to_sim(p_next) == &medium[i]);
+        sim_wait(&medium[i], MEDIUM_SIGNAL);
+    }
+
+    return tick;
+}
+
+static volatile bool stress_done;
+
+static void *irq_thread(void *arg)
+{
+    uint32_t i = 0;
+
+    (void)arg;
+
+    while (!stress_done) {
+        struct sim_partition_t *p_sim = &medium[i++ % NR_MEDIUM_PTS];
+
+        if (p_sim->pt.signals_asserted & MEDIUM_SIGNAL) {
+            sim_wait(p_sim, MEDIUM_SIGNAL);
+        } else {
+            sim_assert(p_sim, MEDIUM_SIGNAL);
+        }
+    }
+
+    return NULL;
+}
+
+static void run_stress(void)
+{
+    pthread_t irq;
+    struct thread_t *p_next;
+    uint32_t i, nr_queued = 0;
+
+    stress_done = false;
+    TEST_ASSERT(pthread_create(&irq, NULL, irq_thread, NULL) == 0);
+
+    for (i = 0; i < NR_STRESS_LOOPS; i++) {
+        client_call();
+        TEST_ASSERT(thrd_next() == &server.pt.thrd);
+        service_get();
+        service_reply();
+        TEST_ASSERT(thrd_next() == &client.pt.thrd);
+    }
+
+    stress_done = true;
+    pthread_join(irq, NULL);
+
+    TEST_ASSERT(server.pt.n_prio_inherited == 0);
+    TEST_ASSERT(server.pt.thrd.state == THRD_STATE_BLOCK);
+
+    /* Every queued thread must be found exactly once, in priority order. */
+    while ((p_next = thrd_next()) != NULL) {
+        TEST_ASSERT(p_next->priority ==
+                    PARTITION_PRIORITY(to_sim(p_next)->ldinf.flags));
+        thrd_set_state(p_next, THRD_STATE_BLOCK);
+        TEST_ASSERT(++nr_queued <= NR_MEDIUM_PTS + 1);
+    }
+}
+
+int main(void)
+{
+    uint32_t latency;
+
+    setup();
+
+    /* Registers the signal query of the backend and runs the client */
+    thrd_set_state(&client.pt.thrd, THRD_STATE_RUNNABLE);
+    (void)backend_system_run();
+    TEST_ASSERT(CURRENT_THREAD == &client.pt.thrd);
+
+    latency = run_request();
+
+    printf("Client reply latency with %u medium partitions runnable: %u "
+           "ticks\n", NR_MEDIUM_PTS, latency);
+
+    TEST_ASSERT(latency == SERVICE_WORK);
+
+    run_stress();
+    printf("Send and reply against concurrent signals: %u loops passed\n",
+           NR_STRESS_LOOPS);
+
+    return 0;
+}
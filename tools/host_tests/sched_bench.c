@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Scheduler microbenchmark of the SPM thread selection.
+ *
+ * It compares the run queues of thread.c, which pick the next thread with a
+ * CLZ on the ready bitmap, with the list walk they replaced. The list walk is
+ * kept below as reference: all the threads are in one list sorted by
+ * priority, and the next thread is the first one which the state query finds
+ * runnable.
+ *
+ * Threads are spread over the priorities, and the lowest priority idle thread
+ * is always runnable. Each iteration wakes one thread with a signal, picks
+ * it, blocks it again and picks the idle thread, as a partition serving a
+ * request does. The time of one scheduling decision is reported.
+ *
+ * Options:
+ *   -n <loops>     Iterations per thread count, default 1000000.
+ *   -t <n,n,...>   Thread counts, default 4,8,16,32.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "critical_section.h"
+#include "thread.h"
+
+#define MAX_THRDS               64
+#define MAX_THRD_COUNTS         8
+
+#define TEST_ASSERT(cond)                                               \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            printf("FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            exit(1);                                                    \
+        }                                                               \
+    } while (0)
+
+/*************************** List walk reference ******************************/
+
+struct lw_thread_t {
+    uint8_t            priority;
+    uint32_t           state;
+    bool               signaled;
+    struct lw_thread_t *next;
+};
+
+static struct lw_thread_t *lw_list_head;
+static struct lw_thread_t *lw_rnbl_head;
+
+static uint32_t lw_query_state(struct lw_thread_t *p_thrd, uint32_t *p_retval)
+{
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+    uint32_t state = p_thrd->state;
+
+    CRITICAL_SECTION_ENTER(cs);
+    if (p_thrd->signaled) {
+        p_thrd->signaled = false;
+        *p_retval = 0;
+        state = THRD_STATE_RET_VAL_AVAIL;
+    }
+    CRITICAL_SECTION_LEAVE(cs);
+
+    return state;
+}
+
+static uint32_t (*volatile lw_query_cb)(struct lw_thread_t *, uint32_t *) =
+                                                                lw_query_state;
+
+static struct lw_thread_t *lw_next(void)
+{
+    struct lw_thread_t *p_thrd = lw_rnbl_head;
+    uint32_t retval = 0;
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+
+    CRITICAL_SECTION_ENTER(cs);
+    while (p_thrd) {
+        p_thrd->state = lw_query_cb(p_thrd, &retval);
+
+        if (p_thrd->state == THRD_STATE_RET_VAL_AVAIL) {
+            p_thrd->state = THRD_STATE_RUNNABLE;
+        }
+
+        if (p_thrd->state == THRD_STATE_RUNNABLE) {
+            break;
+        }
+
+        p_thrd = p_thrd->next;
+    }
+    CRITICAL_SECTION_LEAVE(cs);
+
+    return p_thrd;
+}
+
+static void lw_insert_by_prior(struct lw_thread_t *node)
+{
+    struct lw_thread_t *iter;
+
+    if (lw_list_head == NULL || (node->priority <= lw_list_head->priority)) {
+        node->next = lw_list_head;
+        lw_list_head = node;
+        return;
+    }
+
+    iter = lw_list_head;
+    while (iter->next && (node->priority > iter->next->priority)) {
+        iter = iter->next;
+    }
+
+    node->next = iter->next;
+    iter->next = node;
+}
+
+static void lw_set_state(struct lw_thread_t *p_thrd, uint32_t new_state)
+{
+    p_thrd->state = new_state;
+
+    if ((p_thrd->state == THRD_STATE_RUNNABLE) &&
+        ((lw_rnbl_head == NULL) ||
+         (p_thrd->priority < lw_rnbl_head->priority))) {
+        lw_rnbl_head = p_thrd;
+    } else {
+        lw_rnbl_head = lw_list_head;
+    }
+}
+
+/******************************* Run queues ***********************************/
+
+struct rq_thread_t {
+    struct thread_t thrd;
+    bool            signaled;
+};
+
+/* Mirrors query_state() of the IPC backend */
+static uint32_t rq_query_state(struct thread_t *p_thrd, uint32_t *p_retval)
+{
+    struct rq_thread_t *p_rq = (struct rq_thread_t *)p_thrd;
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+    uint32_t state = p_thrd->state;
+
+    CRITICAL_SECTION_ENTER(cs);
+    if (p_rq->signaled) {
+        p_rq->signaled = false;
+        *p_retval = 0;
+        state = THRD_STATE_RET_VAL_AVAIL;
+    }
+    CRITICAL_SECTION_LEAVE(cs);
+
+    return state;
+}
+
+static void rq_set_state(struct rq_thread_t *p_rq, uint32_t state)
+{
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+
+    CRITICAL_SECTION_ENTER(cs);
+    thrd_set_state(&p_rq->thrd, state);
+    CRITICAL_SECTION_LEAVE(cs);
+}
+
+/******************************* Benchmark ************************************/
+
+static struct lw_thread_t lw_thrds[MAX_THRDS + 1];
+static struct rq_thread_t rq_thrds[MAX_THRDS + 1];
+
+/* Priorities evenly spread above the idle thread */
+static uint8_t bench_priority(uint32_t idx, uint32_t nr_thrds)
+{
+    return (uint8_t)(idx * THRD_PRIOR_LOWEST / nr_thrds);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double bench_list_walk(uint32_t nr_thrds, uint32_t loops)
+{
+    struct lw_thread_t *p_idle = &lw_thrds[nr_thrds];
+    struct lw_thread_t *p_thrd;
+    uint32_t i;
+    double start;
+
+    lw_list_head = NULL;
+    lw_rnbl_head = NULL;
+    for (i = 0; i <= nr_thrds; i++) {
+        memset(&lw_thrds[i], 0, sizeof(lw_thrds[i]));
+        lw_thrds[i].priority = (i == nr_thrds) ? THRD_PRIOR_LOWEST :
+                                                 bench_priority(i, nr_thrds);
+        lw_insert_by_prior(&lw_thrds[i]);
+        lw_set_state(&lw_thrds[i], (i == nr_thrds) ? THRD_STATE_RUNNABLE :
+                                                     THRD_STATE_BLOCK);
+    }
+    TEST_ASSERT(lw_next() == p_idle);
+
+    start = now_ns();
+    for (i = 0; i < loops; i++) {
+        p_thrd = &lw_thrds[i % nr_thrds];
+
+        p_thrd->signaled = true;
+        TEST_ASSERT(lw_next() == p_thrd);
+
+        lw_set_state(p_thrd, THRD_STATE_BLOCK);
+        TEST_ASSERT(lw_next() == p_idle);
+    }
+
+    return (now_ns() - start) / (2.0 * loops);
+}
+
+static double bench_run_queues(uint32_t nr_thrds, uint32_t loops)
+{
+    struct rq_thread_t *p_idle = &rq_thrds[nr_thrds];
+    struct rq_thread_t *p_rq;
+    uint32_t i;
+    double start;
+
+    thrd_set_query_callback(rq_query_state);
+    for (i = 0; i <= nr_thrds; i++) {
+        memset(&rq_thrds[i], 0, sizeof(rq_thrds[i]));
+        THRD_INIT(&rq_thrds[i].thrd, NULL,
+                  (i == nr_thrds) ? THRD_PRIOR_LOWEST :
+                                    bench_priority(i, nr_thrds));
+    }
+    rq_set_state(p_idle, THRD_STATE_RUNNABLE);
+    TEST_ASSERT(thrd_next() == &p_idle->thrd);
+
+    start = now_ns();
+    for (i = 0; i < loops; i++) {
+        p_rq = &rq_thrds[i % nr_thrds];
+
+        /* Mirrors the signal assertion of the IPC backend */
+        p_rq->signaled = true;
+        rq_set_state(p_rq, THRD_STATE_RET_VAL_AVAIL);
+        TEST_ASSERT(thrd_next() == &p_rq->thrd);
+
+        rq_set_state(p_rq, THRD_STATE_BLOCK);
+        TEST_ASSERT(thrd_next() == &p_idle->thrd);
+    }
+
+    /* Leave the run queues empty for the next run */
+    rq_set_state(p_idle, THRD_STATE_BLOCK);
+    TEST_ASSERT(thrd_next() == NULL);
+
+    return (now_ns() - start) / (2.0 * loops);
+}
+
+static uint32_t parse_counts(char *arg, uint32_t *counts)
+{
+    uint32_t nr = 0;
+    char *tok;
+
+    for (tok = strtok(arg, ","); tok && (nr < MAX_THRD_COUNTS);
+         tok = strtok(NULL, ",")) {
+        counts[nr] = (uint32_t)strtoul(tok, NULL, 0);
+        if ((counts[nr] == 0) || (counts[nr] > MAX_THRDS)) {
+            printf("Thread counts must be in 1..%d\n", MAX_THRDS);
+            exit(1);
+        }
+        nr++;
+    }
+
+    return nr;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t counts[MAX_THRD_COUNTS] = { 4, 8, 16, 32 };
+    uint32_t nr_counts = 4, loops = 1000000, i;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:t:")) != -1) {
+        switch (opt) {
+        case 'n':
+            loops = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            nr_counts = parse_counts(optarg, counts);
+            break;
+        default:
+            printf("Usage: %s [-n loops] [-t n,n,...]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("%8s %16s %16s\n", "threads", "list walk ns", "run queues ns");
+    for (i = 0; i < nr_counts; i++) {
+        printf("%8u %16.1f %16.1f\n", counts[i],
+               bench_list_walk(counts[i], loops),
+               bench_run_queues(counts[i], loops));
+    }
+
+    return 0;
+}
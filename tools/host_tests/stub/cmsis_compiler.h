@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host replacement of the CMSIS compiler intrinsics used by the tested code */
+
+#ifndef __HOST_CMSIS_COMPILER_H__
+#define __HOST_CMSIS_COMPILER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef __WEAK
+#define __WEAK                  __attribute__((weak))
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE         static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE    static inline __attribute__((always_inline))
+#endif
+#ifndef __PACKED
+#define __PACKED                __attribute__((packed))
+#endif
+
+static inline uint8_t __CLZ(uint32_t value)
+{
+    return value ? (uint8_t)__builtin_clz(value) : 32U;
+}
+
+/*
+ * Exclusive accesses emulated with a compare-and-swap against the value loaded
+ * by __LDREXW() of the same host thread.
+ */
+#define __ARM_FEATURE_LDREX     0x4
+
+extern __thread uint32_t host_excl_val;
+
+static inline uint32_t __LDREXW(volatile uint32_t *addr)
+{
+    host_excl_val = __atomic_load_n(addr, __ATOMIC_SEQ_CST);
+    return host_excl_val;
+}
+
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t *addr)
+{
+    uint32_t expected = host_excl_val;
+
+    return __atomic_compare_exchange_n(addr, &expected, value, false,
+                                       __ATOMIC_SEQ_CST,
+                                       __ATOMIC_SEQ_CST) ? 0U : 1U;
+}
+
+#define __CLREX()               do {} while (0)
+
+#define __DSB()                 __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DMB()                 __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __ISB()                 __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#endif /* __HOST_CMSIS_COMPILER_H__ */
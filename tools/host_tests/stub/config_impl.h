@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host replacement of the generated SPM implementation configuration */
+
+#ifndef __CONFIG_IMPL_H__
+#define __CONFIG_IMPL_H__
+
+#include "config_tfm.h"
+
+#define CONFIG_TFM_SPM_BACKEND_IPC                               1
+#define CONFIG_TFM_SPM_BACKEND_SFN                               0
+
+#define CONFIG_TFM_CONNECTION_BASED_SERVICE_API                  0
+#define CONFIG_TFM_MMIO_REGION_ENABLE                            0
+#define CONFIG_TFM_FLIH_API                                      0
+#define CONFIG_TFM_SLIH_API                                      0
+
+#define CONFIG_TFM_SPM_THREAD_STACK_SIZE                         0x400
+
+#endif /* __CONFIG_IMPL_H__ */
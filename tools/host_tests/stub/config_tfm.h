@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host replacement of the TF-M build configuration */
+
+#ifndef __CONFIG_TFM_H__
+#define __CONFIG_TFM_H__
+
+#define CONFIG_TFM_BOOT_DATA_INDEX_MAX_NUM      32
+#define CONFIG_TFM_PSA_CALL_BATCH_MAX_NUM       8
+#define CONFIG_TFM_DOORBELL_API                 1
+
+#endif /* __CONFIG_TFM_H__ */
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Host replacement of the SPM critical section. The host threads standing for
+ * the interrupt contexts take the same recursive lock.
+ */
+
+#ifndef __HOST_CRITICAL_SECTION_H__
+#define __HOST_CRITICAL_SECTION_H__
+
+#include <stdint.h>
+
+struct critical_section_t {
+    uint32_t state;
+};
+
+void host_critical_enter(void);
+void host_critical_leave(void);
+
+#define CRITICAL_SECTION_STATIC_INIT   {.state = 0,}
+#define CRITICAL_SECTION_INIT(cs)      (cs).state = (0)
+#define CRITICAL_SECTION_ENTER(cs)     do {                      \
+                                           (void)(cs);           \
+                                           host_critical_enter(); \
+                                       } while (0)
+#define CRITICAL_SECTION_LEAVE(cs)     host_critical_leave()
+
+#endif /* __HOST_CRITICAL_SECTION_H__ */
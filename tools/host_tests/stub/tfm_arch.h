@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host replacement of the architecture hooks called by the SPM scheduler */
+
+#ifndef __HOST_TFM_ARCH_H__
+#define __HOST_TFM_ARCH_H__
+
+#include <stdint.h>
+
+#define SCHEDULER_ATTEMPTED 2 /* Schedule attempt when scheduler is locked. */
+#define SCHEDULER_LOCKED    1
+#define SCHEDULER_UNLOCKED  0
+
+#define EXC_NUM_THREAD_MODE         (0)
+
+/* Context control, only referenced by the SPM data structures on the host */
+struct context_ctrl_t {
+    uint32_t                sp;
+    uint32_t                exc_ret;
+    uint32_t                sp_limit;
+    uint32_t                sp_base;
+};
+
+struct tfm_additional_context_t {
+    uint32_t    integ_sign;
+    uint32_t    reserved;
+    uint32_t    callee[8];
+};
+
+/* Host addresses do not fit the context control, stacks are not used */
+#define ARCH_CLAIM_CTXCTRL_INSTANCE(name, stack_buf, stack_size)            \
+            struct context_ctrl_t name = {                                  \
+                .sp        = (uint32_t)sizeof(stack_buf),                   \
+                .sp_base   = (uint32_t)(stack_size),                        \
+                .sp_limit  = 0,                                             \
+                .exc_ret   = 0,                                             \
+            }
+#define ARCH_CTXCTRL_INIT(x, buf, sz)               \
+                                    do { (void)(buf); (void)(sz); } while (0)
+#define ARCH_CTXCTRL_ALLOCATE_STACK(x, size)        ((void)(x), (void)(size))
+#define ARCH_CTXCTRL_ALLOCATED_PTR(x)               ((void)(x), 0U)
+#define ARCH_FLUSH_FP_CONTEXT()                     do {} while (0)
+
+#define tfm_arch_set_context_ret_code(p_ctx, ret)   \
+                                    do { (void)(p_ctx); (void)(ret); } while (0)
+#define tfm_arch_init_context(p_ctx, pfn, param, pfnlr)                     \
+                                    do {                                    \
+                                        (void)(p_ctx); (void)(pfn);         \
+                                        (void)(param); (void)(pfnlr);       \
+                                    } while (0)
+#define tfm_arch_refresh_hardware_context(p_ctx)    ((void)(p_ctx), 0U)
+#define arch_attempt_schedule()                     ((void)0)
+#define arch_seal_thread_stack(stk)                 ((void)(stk))
+#define arch_acquire_sched_lock()                   ((void)0)
+#define arch_release_sched_lock()                   SCHEDULER_UNLOCKED
+
+#define __get_PSP()                                 0U
+#define __get_active_exc_num()                      EXC_NUM_THREAD_MODE
+
+#endif /* __HOST_TFM_ARCH_H__ */
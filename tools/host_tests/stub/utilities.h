@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2023, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host replacement of the SPM utilities */
+
+#ifndef __HOST_UTILITIES_H__
+#define __HOST_UTILITIES_H__
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPM_ASSERT(cond)    assert(cond)
+#define spm_memcpy          memcpy
+#define spm_memset          memset
+#define tfm_core_panic()    abort()
+
+#define TO_CONTAINER(ptr, type, member) \
+    (type *)((unsigned long)(ptr) - offsetof(type, member))
+
+#define STRINGIFY_EXPAND(x) #x
+#define M2S(m) STRINGIFY_EXPAND(m)
+
+#endif /* __HOST_UTILITIES_H__ */
@@ -0,0 +1,230 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2023, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+"""
+Decode a dump of the SPM trace buffer (CONFIG_TFM_SPM_TRACE).
+
+Dump the buffer with a debugger, for example in GDB:
+    dump binary value trace.bin spm_trace_buffer
+
+Then run:
+    python3 spm_trace_decode.py trace.bin [--timeline] [--cpu-hz 100000000]
+
+Besides the per service latencies, it reports the latency from the entry of
+each secure interrupt to its FLIH function, and to the wake-up of the owner
+partition by the IRQ signal, and the boot time to the NS entry with the
+Secure Partitions started at boot or lazily afterwards.
+"""
+
+import argparse
+import struct
+import sys
+
+SPM_TRACE_MAGIC   = 0x54505346
+SPM_TRACE_VERSION = 1
+
+# struct spm_trace_buffer_t header and struct spm_trace_record_t
+HEADER_FMT = '<IHHIII'
+RECORD_FMT = '<IBBHI'
+
+# Event IDs, keep in sync with secure_fw/spm/core/spm_trace.h
+EVENTS = {
+    1: 'CALL_ENTER',
+    2: 'CALL_EXIT',
+    3: 'MESSAGING',
+    4: 'REPLYING',
+    5: 'SCHEDULE',
+    6: 'BOUNDARY',
+    7: 'IRQ',
+    8: 'MAILBOX',
+    9: 'FLIH',
+    10: 'WAKEUP',
+    11: 'START',
+}
+
+EVT_CALL_ENTER = 1
+EVT_CALL_EXIT  = 2
+EVT_MESSAGING  = 3
+EVT_REPLYING   = 4
+EVT_SCHEDULE   = 5
+EVT_IRQ        = 7
+EVT_FLIH       = 9
+EVT_WAKEUP     = 10
+EVT_START      = 11
+
+# Flags of EVT_START
+START_LAZY     = 0x1
+START_NS_AGENT = 0x2
+
+def load_records(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    hdr_size = struct.calcsize(HEADER_FMT)
+    if len(data) < hdr_size:
+        sys.exit('Dump is too short')
+
+    magic, version, rec_size, capacity, ts_is_cycles, head = \
+        struct.unpack_from(HEADER_FMT, data, 0)
+    if magic != SPM_TRACE_MAGIC:
+        sys.exit('Bad magic 0x{:08x}, not an SPM trace buffer'.format(magic))
+    if version != SPM_TRACE_VERSION:
+        sys.exit('Unsupported trace version {}'.format(version))
+    if rec_size != struct.calcsize(RECORD_FMT):
+        sys.exit('Unexpected record size {}'.format(rec_size))
+    if len(data) < hdr_size + capacity * rec_size:
+        sys.exit('Dump is shorter than the {} records'.format(capacity))
+
+    # Oldest record first. Records before the ring wrapped are lost.
+    count = min(head, capacity)
+    records = []
+    for seq in range(head - count, head):
+        offset = hdr_size + (seq % capacity) * rec_size
+        ts, evt, _, pid, arg = struct.unpack_from(RECORD_FMT, data, offset)
+        records.append((ts, evt, pid, arg))
+
+    return records, ts_is_cycles, head - count
+
+def elapsed(start, end):
+    # The 32-bit cycle counter may wrap between two events
+    return (end - start) & 0xFFFFFFFF
+
+def fmt_time(ticks, cpu_hz):
+    if cpu_hz:
+        return '{:10.2f}us'.format(ticks * 1000000.0 / cpu_hz)
+    return '{:10d}'.format(ticks)
+
+def print_timeline(records, cpu_hz):
+    print('Timeline:')
+    base = records[0][0] if records else 0
+    for ts, evt, pid, arg in records:
+        print('  {} {:<10} pid {:5d} arg 0x{:08x}'.format(
+              fmt_time(elapsed(base, ts), cpu_hz),
+              EVENTS.get(evt, 'EVT_{}'.format(evt)), pid, arg))
+    print()
+
+def print_latencies(records, ts_is_cycles, cpu_hz):
+    # Client view: psa_call() entry to the reply delivered to the client
+    pending_call = {}
+    # Service view: message delivery to psa_reply(), per SID
+    pending_msg = {}
+    call_stats = {}
+    service_stats = {}
+
+    for ts, evt, pid, arg in records:
+        if evt == EVT_CALL_ENTER:
+            pending_call[pid] = (ts, arg)
+        elif evt == EVT_CALL_EXIT and pid in pending_call:
+            start, sid = pending_call.pop(pid)
+            call_stats.setdefault(sid, []).append(elapsed(start, ts))
+        elif evt == EVT_MESSAGING:
+            pending_msg.setdefault(arg, []).append(ts)
+        elif evt == EVT_REPLYING and pending_msg.get(arg):
+            start = pending_msg[arg].pop(0)
+            service_stats.setdefault(arg, []).append(elapsed(start, ts))
+
+    unit = 'time' if cpu_hz else 'cycles' if ts_is_cycles else 'events'
+    print('Per service latency ({}):'.format(unit))
+    print('  {:>10} {:>6} {:>12} {:>12} {:>12} {:>12}'.format(
+          'SID', 'calls', 'call avg', 'call max', 'service avg', 'service max'))
+    for sid in sorted(set(call_stats) | set(service_stats)):
+        calls = call_stats.get(sid, [])
+        served = service_stats.get(sid, [])
+        print('  0x{:08x} {:>6} {:>12} {:>12} {:>12} {:>12}'.format(
+              sid, max(len(calls), len(served)),
+              fmt_time(sum(calls) // len(calls), cpu_hz) if calls else '-',
+              fmt_time(max(calls), cpu_hz) if calls else '-',
+              fmt_time(sum(served) // len(served), cpu_hz) if served else '-',
+              fmt_time(max(served), cpu_hz) if served else '-'))
+
+def print_irq_latencies(records, ts_is_cycles, cpu_hz):
+    # Interrupt entry to the FLIH function, and to the owner partition woken
+    # up by the IRQ signal, per IRQ source
+    pending_irq = {}
+    flih_stats = {}
+    wakeup_stats = {}
+
+    for ts, evt, pid, arg in records:
+        if evt == EVT_IRQ:
+            pending_irq[pid] = (ts, arg)
+        elif evt == EVT_FLIH and pid in pending_irq:
+            start, source = pending_irq[pid]
+            flih_stats.setdefault(source, []).append(elapsed(start, ts))
+        elif evt == EVT_WAKEUP and pid in pending_irq:
+            start, source = pending_irq.pop(pid)
+            wakeup_stats.setdefault(source, []).append(elapsed(start, ts))
+
+    if not flih_stats and not wakeup_stats:
+        return
+
+    unit = 'time' if cpu_hz else 'cycles' if ts_is_cycles else 'events'
+    print()
+    print('Per IRQ source latency ({}):'.format(unit))
+    print('  {:>10} {:>12} {:>12} {:>12} {:>12}'.format(
+          'source', 'FLIH avg', 'FLIH max', 'wakeup avg', 'wakeup max'))
+    for source in sorted(set(flih_stats) | set(wakeup_stats)):
+        flih = flih_stats.get(source, [])
+        wakeup = wakeup_stats.get(source, [])
+        print('  {:>10} {:>12} {:>12} {:>12} {:>12}'.format(
+              source,
+              fmt_time(sum(flih) // len(flih), cpu_hz) if flih else '-',
+              fmt_time(max(flih), cpu_hz) if flih else '-',
+              fmt_time(sum(wakeup) // len(wakeup), cpu_hz) if wakeup else '-',
+              fmt_time(max(wakeup), cpu_hz) if wakeup else '-'))
+
+def print_boot(records, lost, ts_is_cycles, cpu_hz):
+    # The NS entry is the first schedule of the NS Agent, or its START event
+    # when the SFN backend does not schedule.
+    starts = [(ts, pid, arg) for ts, evt, pid, arg in records if evt == EVT_START]
+    if not starts:
+        return
+    if lost:
+        print('\nBoot: the first records are overwritten, no boot report')
+        return
+
+    base = records[0][0]
+    ns_entry = None
+    for ts, pid, arg in starts:
+        if arg & START_NS_AGENT:
+            ns_pid, ns_entry = pid, ts
+    if ns_entry is not None:
+        for ts, evt, pid, _ in records:
+            if evt == EVT_SCHEDULE and pid == ns_pid:
+                ns_entry = ts
+                break
+
+    unit = 'time' if cpu_hz else 'cycles' if ts_is_cycles else 'events'
+    print()
+    print('Boot ({}):'.format(unit))
+    if ns_entry is not None:
+        print('  NS entry            {}'.format(
+              fmt_time(elapsed(base, ns_entry), cpu_hz)))
+    for ts, pid, arg in starts:
+        if arg & START_NS_AGENT:
+            continue
+        print('  pid {:5d} {:<9} {}'.format(
+              pid, 'lazy' if arg & START_LAZY else 'boot',
+              fmt_time(elapsed(base, ts), cpu_hz)))
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Decode an SPM trace dump')
+    parser.add_argument('dump', help='Binary dump of spm_trace_buffer')
+    parser.add_argument('--timeline', action='store_true',
+                        help='Print every event in order')
+    parser.add_argument('--cpu-hz', type=int, default=0,
+                        help='Core clock, to print times instead of cycles')
+    args = parser.parse_args()
+
+    records, ts_is_cycles, lost = load_records(args.dump)
+    cpu_hz = args.cpu_hz if ts_is_cycles else 0
+
+    print('{} records decoded, {} overwritten\n'.format(len(records), lost))
+    if args.timeline:
+        print_timeline(records, cpu_hz)
+    print_latencies(records, ts_is_cycles, cpu_hz)
+    print_irq_latencies(records, ts_is_cycles, cpu_hz)
+    print_boot(records, lost, ts_is_cycles, cpu_hz)
@@ -119,6 +119,16 @@ def manifest_validation(manifest, pid):
     if 'ns_agent' not in manifest:
         manifest['ns_agent'] = False
 
+    # "lazy_start" validation, NS Agents and Partitions owning IRQs must start at boot
+    if 'lazy_start' not in manifest:
+        manifest['lazy_start'] = False
+    elif manifest['lazy_start'] not in [True, False]:
+        raise Exception('Invalid lazy_start of {}'.format(manifest['name']))
+    elif manifest['lazy_start'] and manifest['ns_agent']:
+        raise Exception('NS Agent {} cannot be lazy_start'.format(manifest['name']))
+    elif manifest['lazy_start'] and len(irq_list) > 0:
+        raise Exception('{} owns IRQs and cannot be lazy_start'.format(manifest['name']))
+
     # Every PSA Partition must have at least either a secure service or an IRQ
     if (pid == None or pid >= TFM_PID_BASE) \
        and len(service_list) == 0 and len(irq_list) == 0:
@@ -221,6 +231,76 @@ def validate_dependency_chain(partition,
         validate_dependency_chain(dependency, dependency_table, dependency_chain)
     dependency_table[partition]['validated'] = True
 
+def process_sid_hash_table(partitions):
+    """
+    This function finds a perfect hash for the SIDs of all the services, so
+    that SPM resolves a SID with one multiplication and shift:
+
+        slot = (SID * MULT mod 2^32) >> (32 - BITS)
+
+    Slots are unique for every SID. It also builds the dependency bitmap of
+    each partition, with one bit per slot set for each dependency.
+
+    Inputs:
+        - partitions:   list of partitions
+
+    Returns the dict of the hash parameters.
+    """
+
+    SID_HASH_BITS_MIN = 1
+    SID_HASH_BITS_MAX = 10
+    SID_HASH_MULT_TRIES = 4096
+
+    service_sid_map = {}
+    for partition in partitions:
+        for service in partition['manifest'].get('services', []):
+            service_sid_map[service['name']] = int(str(service['sid']), 0)
+
+    sids = list(service_sid_map.values())
+
+    # Start from the smallest table which can hold all the SIDs
+    bits = max(SID_HASH_BITS_MIN, (len(sids) - 1).bit_length())
+    found = False
+    while not found and bits <= SID_HASH_BITS_MAX:
+        # Odd multipliers derived from the golden ratio, deterministic
+        mult = 0x9E3779B1
+        for _ in range(SID_HASH_MULT_TRIES):
+            slots = [((sid * mult) & 0xFFFFFFFF) >> (32 - bits) for sid in sids]
+            if len(set(slots)) == len(slots):
+                found = True
+                break
+            mult = ((mult * 1664525 + 1013904223) & 0xFFFFFFFF) | 1
+        if not found:
+            bits += 1
+
+    if not found:
+        raise Exception('No perfect hash found for {} SIDs'.format(len(sids)))
+
+    size = 1 << bits
+
+    # Dependency bitmap of each partition, indexed by slot
+    for partition in partitions:
+        manifest = partition['manifest']
+        dependencies = manifest.get('dependencies', []) + \
+                       manifest.get('weak_dependencies', [])
+        bitmap = [0] * ((size + 31) // 32)
+        for dependency in dependencies:
+            # Weak dependencies may refer to services not built in
+            if dependency not in service_sid_map:
+                continue
+            slot = ((service_sid_map[dependency] * mult) & 0xFFFFFFFF) >> (32 - bits)
+            bitmap[slot // 32] |= 1 << (slot % 32)
+        partition['deps_bitmap'] = ['0x{0:08x}'.format(w) for w in bitmap]
+        partition['has_deps_bitmap'] = any(bitmap)
+
+    logging.debug('SID hash table: {} slots for {} SIDs, multiplier 0x{:08x}'
+                  .format(size, len(sids), mult))
+
+    return {
+        'bits': bits,
+        'mult': '0x{0:08x}'.format(mult)
+    }
+
 def manifest_attribute_check(manifest, manifest_item):
     """
     Check whether Non-FF-M compliant attributes are explicitly registered in manifest lists.
@@ -395,7 +475,9 @@ def process_partition_manifests(manifest_lists, configs):
         # number (0) when there are no irqs.
         irq_idx = -1
         for irq_idx, irq in enumerate(manifest.get('irqs', [])):
-            # Assign signal value, from the most significant bit
+            # Assign signal value, from the most significant bit. The SPM
+            # finds the IRQ load info of a signal by its bit position, so the
+            # IRQs must be generated in this order.
             irq['signal_value'] = (1 << (31 - irq_idx))
             if irq.get('handling', None) == 'FLIH':
                 partition_statistics['flih_num'] += 1
@@ -437,6 +519,8 @@ def process_partition_manifests(manifest_lists, configs):
 
     check_circular_dependency(partition_list, service_partition_map)
 
+    sid_hash = process_sid_hash_table(partition_list)
+
     # Automatically assign PIDs for partitions without 'pid' attribute
     pid = max(pid_list, default = TFM_PID_BASE - 1)
     for idx in no_pid_manifest_idx:
@@ -473,6 +557,7 @@ def process_partition_manifests(manifest_lists, configs):
     context['partitions'] = partition_list
     context['config_impl'] = config_impl
     context['stateless_services'] = process_stateless_services(partition_list)
+    context['sid_hash'] = sid_hash
 
     return context
 
@@ -501,6 +586,8 @@ def gen_per_partition_files(context):
         partition_context['attr'] = one_partition['attr']
         partition_context['manifest_out_basename'] = one_partition['manifest_out_basename']
         partition_context['numbered_priority'] = one_partition['numbered_priority']
+        partition_context['deps_bitmap'] = one_partition['deps_bitmap']
+        partition_context['has_deps_bitmap'] = one_partition['has_deps_bitmap']
 
         logging.info ('Generating {} in {}'.format(one_partition['attr']['description'],
                                             one_partition['output_dir']))